@@ -2,9 +2,10 @@
 #include <algorithm>
 
 #define MSG_DEFAULT __FUNCTION__
-#define COMPLOG(logger, msg, rc)\
-if (logger != nullptr) {\
-    logger->log(msg, rc);\
+#define COMPLOG(logger, msg, rc) COMPLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define COMPLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
 }
 
 namespace {
@@ -50,6 +51,16 @@ namespace {
     };
 }
 
+/* coordinates of vec as one contiguous buffer, copied into buffer when vec does not store them contiguously */
+static double const *coordsOf(IVector const *vec, std::vector<double> &buffer) {
+    double const *data = vec->getData();
+    if (data != nullptr)
+        return data;
+    buffer.resize(vec->getDim());
+    vec->getCoords(0, vec->getDim(), buffer.data());
+    return buffer.data();
+} //OK
+
 CompactImpl::CompactImpl(size_t dim, IVector *begin, IVector *end) : dim_{dim}, begin_{begin}, end_{end} {
     this->logger_ = ILogger::createLogger(this);
 } //OK
@@ -228,9 +239,14 @@ ReturnCode CompactImpl::contains(const IVector *vec, bool &result) const {
         return ReturnCode::RC_WRONG_DIM;
     }
 
+    std::vector<double> beginBuffer, endBuffer, vecBuffer;
+    double const *begin = coordsOf(this->begin_, beginBuffer);
+    double const *end = coordsOf(this->end_, endBuffer);
+    double const *coords = coordsOf(vec, vecBuffer);
+
     result = true;
     for (size_t i = 0; result && i < this->dim_; ++i)
-        result &= (this->begin_->getCoord(i) <= vec->getCoord(i) && vec->getCoord(i) <= this->end_->getCoord(i));
+        result = (begin[i] <= coords[i] && coords[i] <= end[i]);
 
     return ReturnCode::RC_SUCCESS;
 } //OK
@@ -283,10 +299,15 @@ ReturnCode CompactImpl::intersects(const ICompact *comp, bool &result) const {
         return ReturnCode::RC_NULL_PTR;
     }
 
+    std::vector<double> beginBuffer, endBuffer, compBeginBuffer, compEndBuffer;
+    double const *begin = coordsOf(this->begin_, beginBuffer);
+    double const *end = coordsOf(this->end_, endBuffer);
+    double const *otherBegin = coordsOf(compBegin, compBeginBuffer);
+    double const *otherEnd = coordsOf(compEnd, compEndBuffer);
+
     result = true;
-    for (size_t i = 0; i < this->dim_; ++i) {
-        result &= (std::max(this->begin_->getCoord(i), compBegin->getCoord(i)) <= std::min(this->end_->getCoord(i), compEnd->getCoord(i)));
-    }
+    for (size_t i = 0; result && i < this->dim_; ++i)
+        result = (std::max(begin[i], otherBegin[i]) <= std::min(end[i], otherEnd[i]));
 
     delete compBegin;
     delete compEnd;
@@ -345,16 +366,21 @@ ReturnCode CompactImpl::IteratorImpl::setDirection(const std::vector<size_t> &di
 } //OK
 
 ReturnCode CompactImpl::IteratorImpl::doStep() {
+    std::vector<double> stepBuffer, beginBuffer, endBuffer;
+    double const *step = coordsOf(this->step_, stepBuffer);
+    double const *begin = coordsOf(this->begin_, beginBuffer);
+    double const *end = coordsOf(this->end_, endBuffer);
+
     bool inside = false;
     for (size_t i = 0; i < this->direction_.size(); ++i) {
-        size_t axis = this->direction_.at(i);
-        double coord = this->current_->getCoord(axis) + this->step_->getCoord(axis);
-        inside = (this->step_->getCoord(axis) > 0 ? coord <= this->end_->getCoord(axis) : coord >= this->end_->getCoord(axis));
+        size_t axis = this->direction_[i];
+        double coord = this->current_->getCoord(axis) + step[axis];
+        inside = (step[axis] > 0 ? coord <= end[axis] : coord >= end[axis]);
         if (inside) {
             this->current_->setCoord(axis, coord);
             break;
         } else {
-            this->current_->setCoord(axis, this->begin_->getCoord(axis));
+            this->current_->setCoord(axis, begin[axis]);
         }
     }
 
@@ -362,11 +388,10 @@ ReturnCode CompactImpl::IteratorImpl::doStep() {
         return ReturnCode::RC_SUCCESS;
     }
 
-    for (size_t i = 0; i < this->end_->getDim(); ++i) {
-        this->current_->setCoord(i, this->end_->getCoord(i));
-    }
+    this->current_->setCoords(0, this->end_->getDim(), end);
 
-    COMPLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+    /* reached by every iteration that runs to the end */
+    COMPLOG_SEV(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS, ILogger::Severity::SEV_DEBUG);
     return ReturnCode::RC_OUT_OF_BOUNDS;
 } //OK
 
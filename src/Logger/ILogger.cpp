@@ -3,6 +3,26 @@
 
 ILogger::~ILogger() {}
 
+const size_t ILogger::ASYNC_CAPACITY;
+const size_t ILogger::RATE_BURST;
+const size_t ILogger::RATE_PERIOD_MS;
+std::atomic<int> ILogger::threshold_(static_cast<int>(ILogger::Severity::SEV_INFO));
+
 ILogger *ILogger::createLogger(void *client) {
     return LoggerImpl::addClient(client);
 }
+
+void ILogger::setThreshold(ILogger::Severity threshold) {
+    ILogger::threshold_.store(static_cast<int>(threshold), std::memory_order_relaxed);
+}
+
+ILogger::Severity ILogger::getThreshold() {
+    return static_cast<ILogger::Severity>(ILogger::threshold_.load(std::memory_order_relaxed));
+}
+
+ReturnCode ILogger::setRateLimit(size_t burst, size_t periodMs) {
+    if (burst > 0 && periodMs == 0)
+        return ReturnCode::RC_INVALID_PARAMS;
+    LogLimiter::configure(burst, periodMs);
+    return ReturnCode::RC_SUCCESS;
+} //OK
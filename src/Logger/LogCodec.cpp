@@ -0,0 +1,229 @@
+#include "LogCodec.h"
+#include <cstring>
+
+static const char *msgMask = "%d.--Function:[%s]--ReturnCode:[%d]--Message:[%s]";
+static const char *dropMask = "--Dropped:[%zu] records";
+static const char *repeatMask = "%d.--Function:[%s]--ReturnCode:[%d]--Repeated:[%zu] times in [%lld] ms";
+static const unsigned char magic[4] = {'U', 'L', 'O', 'G'};
+
+static char const* msgDefaults[(size_t)ReturnCode::RC_UNKNOWN + 1] = {
+        "It's OK",
+        "Can not allocate memory",
+        "Null pointer passed as argument",
+        "Degenerate mathematical object",
+        "Mismatch of dimensions of mathematical objects",
+        "NAN value passed as argument",
+        "Index exceeds the number of elements in container",
+        "Can not open file",
+        "This element not found",
+        "Invalid arguments passed",
+        "Object requires initialization",
+        "Uknown return"
+};
+
+const unsigned char LogEncoder::VERSION;
+
+int formatLogLine(char *line, size_t size, size_t counter, char const *function, ReturnCode rc) {
+    size_t index = (size_t)rc <= (size_t)ReturnCode::RC_UNKNOWN ? (size_t)rc : (size_t)ReturnCode::RC_UNKNOWN;
+    return snprintf(line, size, msgMask, (int)counter, function, (int)rc, msgDefaults[index]);
+} //OK
+
+int formatDroppedLine(char *line, size_t size, size_t dropped) {
+    return snprintf(line, size, dropMask, dropped);
+} //OK
+
+int formatRepeatedLine(char *line, size_t size, LogRecord const &summary) {
+    return snprintf(line, size, repeatMask, (int)summary.counter, summary.function, (int)summary.rc, summary.repeated, (long long)summary.span);
+} //OK
+
+LogEncoder::LogEncoder() : file_{nullptr}, headerPending_{false}, epoch_{0}, lastTimestamp_{0}, lastCounter_{0}, used_{0} {
+    memset(this->sites_, 0, sizeof(this->sites_));
+    memset(this->pointers_, 0, sizeof(this->pointers_));
+    memset(this->pointerIds_, 0, sizeof(this->pointerIds_));
+} //OK
+
+void LogEncoder::reset(FILE *file, int64_t epoch) {
+    this->file_ = file;
+    this->headerPending_ = true;
+    this->epoch_ = epoch;
+    this->lastTimestamp_ = 0;
+    this->lastCounter_ = 0;
+    this->used_ = 0;
+    memset(this->sites_, 0, sizeof(this->sites_));
+    memset(this->pointers_, 0, sizeof(this->pointers_));
+} //OK
+
+void LogEncoder::reserve() {
+    if (BUFFER_SIZE - this->used_ < MAX_ENTRY)
+        this->flush();
+    if (this->headerPending_) {
+        memcpy(this->buffer_ + this->used_, magic, sizeof(magic));
+        this->buffer_[this->used_ + sizeof(magic)] = LogEncoder::VERSION;
+        this->used_ += sizeof(magic) + 1;
+        this->putSigned(this->epoch_);
+        this->headerPending_ = false;
+    }
+} //OK
+
+void LogEncoder::putVarint(uint64_t value) {
+    while (value >= 0x80) {
+        this->buffer_[this->used_++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    this->buffer_[this->used_++] = (unsigned char)value;
+} //OK
+
+void LogEncoder::putSigned(int64_t value) {
+    /* zigzag: small magnitudes of either sign take few bytes */
+    this->putVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+} //OK
+
+size_t LogEncoder::intern(char const *function) {
+    /* the slot is checked by content, as the same pointer may hold another name by now */
+    size_t pointerSlot = ((size_t)function >> 4 ^ (size_t)function >> 12) & (POINTER_SLOTS - 1);
+    if (this->pointers_[pointerSlot] == function &&
+        strncmp(this->sites_[this->pointerIds_[pointerSlot]], function, LogRecord::FUNCTION_SIZE - 1) == 0)
+        return this->pointerIds_[pointerSlot];
+
+    /* FNV-1a */
+    uint64_t hash = 14695981039346656037ULL;
+    size_t length = 0;
+    for (; length < LogRecord::FUNCTION_SIZE - 1 && function[length] != '\0'; ++length)
+        hash = (hash ^ (unsigned char)function[length]) * 1099511628211ULL;
+
+    size_t id = (size_t)(hash ^ (hash >> 32)) & (SITE_SLOTS - 1);
+    this->pointers_[pointerSlot] = function;
+    this->pointerIds_[pointerSlot] = id;
+    char *site = this->sites_[id];
+    if (strncmp(site, function, length) == 0 && site[length] == '\0')
+        return id;
+
+    memcpy(site, function, length);
+    site[length] = '\0';
+    this->buffer_[this->used_++] = LOG_ENTRY_SITE;
+    this->putVarint(id);
+    this->putVarint(length);
+    memcpy(this->buffer_ + this->used_, function, length);
+    this->used_ += length;
+    return id;
+} //OK
+
+void LogEncoder::add(LogRecord const &record) {
+    if (record.repeated == 0) {
+        this->add(record.function, record.rc, record.severity, record.timestamp, record.counter);
+        return;
+    }
+    this->putRecord(LOG_ENTRY_REPEATED, record.function, record.rc, record.severity, record.timestamp, record.counter);
+    this->putVarint(record.repeated);
+    this->putSigned(record.span);
+} //OK
+
+void LogEncoder::add(char const *function, ReturnCode rc, int severity, int64_t timestamp, size_t counter) {
+    this->putRecord(LOG_ENTRY_RECORD, function, rc, severity, timestamp, counter);
+} //OK
+
+void LogEncoder::putRecord(LogEntry kind, char const *function, ReturnCode rc, int severity, int64_t timestamp, size_t counter) {
+    this->reserve();
+    size_t id = this->intern(function);
+    this->buffer_[this->used_++] = kind;
+    this->putVarint(id);
+    this->buffer_[this->used_++] = (unsigned char)(((unsigned)rc & 0x0F) | ((unsigned)severity & 0x0F) << 4);
+    this->putSigned(timestamp - this->lastTimestamp_);
+    this->putSigned((int64_t)counter - this->lastCounter_);
+    this->lastTimestamp_ = timestamp;
+    this->lastCounter_ = (int64_t)counter;
+} //OK
+
+void LogEncoder::addDropped(size_t dropped) {
+    this->reserve();
+    this->buffer_[this->used_++] = LOG_ENTRY_DROPPED;
+    this->putVarint(dropped);
+} //OK
+
+void LogEncoder::flush() {
+    if (this->used_ > 0 && this->file_ != nullptr)
+        fwrite(this->buffer_, 1, this->used_, this->file_);
+    this->used_ = 0;
+} //OK
+
+LogDecoder::LogDecoder(FILE *file) : file_{file}, headerRead_{false}, lastTimestamp_{0}, lastCounter_{0} {
+    memset(this->sites_, 0, sizeof(this->sites_));
+} //OK
+
+bool LogDecoder::getVarint(uint64_t &value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int byte = fgetc(this->file_);
+        if (byte == EOF)
+            return false;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+} //OK
+
+bool LogDecoder::getSigned(int64_t &value) {
+    uint64_t zigzag;
+    if (!this->getVarint(zigzag))
+        return false;
+    value = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+    return true;
+} //OK
+
+ReturnCode LogDecoder::next(LogRecord &record, size_t &dropped) {
+    dropped = 0;
+    if (this->file_ == nullptr)
+        return ReturnCode::RC_NULL_PTR;
+    if (!this->headerRead_) {
+        unsigned char header[sizeof(magic) + 1];
+        if (fread(header, 1, sizeof(header), this->file_) != sizeof(header) || memcmp(header, magic, sizeof(magic)) != 0 ||
+            header[sizeof(magic)] != LogEncoder::VERSION || !this->getSigned(this->lastTimestamp_))
+            return ReturnCode::RC_INVALID_PARAMS;
+        this->headerRead_ = true;
+    }
+
+    for (;;) {
+        int kind = fgetc(this->file_);
+        if (kind == EOF)
+            return ReturnCode::RC_ELEM_NOT_FOUND;
+
+        uint64_t id, value;
+        if (kind == LOG_ENTRY_SITE) {
+            if (!this->getVarint(id) || id >= SITE_SLOTS || !this->getVarint(value) || value >= LogRecord::FUNCTION_SIZE ||
+                fread(this->sites_[id], 1, (size_t)value, this->file_) != value)
+                return ReturnCode::RC_INVALID_PARAMS;
+            this->sites_[id][value] = '\0';
+        } else if (kind == LOG_ENTRY_RECORD || kind == LOG_ENTRY_REPEATED) {
+            int64_t timestampDelta, counterDelta;
+            int codes;
+            if (!this->getVarint(id) || id >= SITE_SLOTS || (codes = fgetc(this->file_)) == EOF ||
+                !this->getSigned(timestampDelta) || !this->getSigned(counterDelta))
+                return ReturnCode::RC_INVALID_PARAMS;
+            this->lastTimestamp_ += timestampDelta;
+            this->lastCounter_ += counterDelta;
+
+            record.counter = (size_t)this->lastCounter_;
+            record.timestamp = this->lastTimestamp_;
+            record.rc = (ReturnCode)(codes & 0x0F);
+            record.severity = codes >> 4;
+            memcpy(record.function, this->sites_[id], LogRecord::FUNCTION_SIZE);
+            record.repeated = 0;
+            record.span = 0;
+            if (kind == LOG_ENTRY_REPEATED && (!this->getVarint(value) || !this->getSigned(record.span)))
+                return ReturnCode::RC_INVALID_PARAMS;
+            if (kind == LOG_ENTRY_REPEATED)
+                record.repeated = (size_t)value;
+            return ReturnCode::RC_SUCCESS;
+        } else if (kind == LOG_ENTRY_DROPPED) {
+            if (!this->getVarint(value))
+                return ReturnCode::RC_INVALID_PARAMS;
+            if (value > 0) {
+                dropped = (size_t)value;
+                return ReturnCode::RC_SUCCESS;
+            }
+        } else {
+            return ReturnCode::RC_INVALID_PARAMS;
+        }
+    }
+} //OK
@@ -0,0 +1,105 @@
+#ifndef LOGCODEC_H
+#define LOGCODEC_H
+
+#include "LogQueue.h"
+#include <cstddef> // size_t
+#include <cstdint>
+#include <cstdio>
+
+/* text line of a record without the trailing newline, truncated to size; the length written, -1 on error */
+DLL_LOCAL_VISIBILITY int formatLogLine(char *line, size_t size, size_t counter, char const *function, ReturnCode rc);
+/* the line reporting records an asynchronous queue dropped, in the same way */
+DLL_LOCAL_VISIBILITY int formatDroppedLine(char *line, size_t size, size_t dropped);
+/* the line of a summary record, one with repeated set */
+DLL_LOCAL_VISIBILITY int formatRepeatedLine(char *line, size_t size, LogRecord const &summary);
+
+/* Binary log stream: the bytes "ULOG", a version byte and the signed epoch, the microseconds since the epoch
+ * at timestamp 0, then entries each starting with an entry kind byte. Integers are LEB128 varints, signed ones
+ * zigzag-encoded first.
+ *   LOG_ENTRY_SITE     id, name length, name - gives a call-site id its function name, replacing any previous one
+ *   LOG_ENTRY_RECORD   site id, rc | severity << 4 byte, timestamp and counter deltas from the previous record
+ *   LOG_ENTRY_DROPPED  number of records the asynchronous queue dropped
+ *   LOG_ENTRY_REPEATED a LOG_ENTRY_RECORD followed by the number of suppressed repeats and their span */
+enum LogEntry {
+    LOG_ENTRY_SITE     = 0,
+    LOG_ENTRY_RECORD   = 1,
+    LOG_ENTRY_DROPPED  = 2,
+    LOG_ENTRY_REPEATED = 3
+};
+
+/* Turns records into the binary stream. Call sites are interned in a fixed table indexed by a hash of the
+ * name, so a name costs its bytes once and then one or two bytes per record; names colliding on a slot
+ * re-send their LOG_ENTRY_SITE when they alternate. A second table remembers the slot last found for a
+ * name pointer, so the usual __FUNCTION__ literal is looked up with one string compare instead of a hash.
+ * Not thread-safe. */
+class DLL_LOCAL_VISIBILITY LogEncoder {
+    public:
+        static const unsigned char VERSION = 2;
+
+        LogEncoder();
+
+        /* starts a new stream into file: the header is written before the next entry, sites and deltas restart;
+         * record timestamps count from epoch, which the header holds so that they decode as time since the epoch */
+        void reset(FILE *file, int64_t epoch);
+        void add(LogRecord const &record);
+        /* an ordinary record without a LogRecord; names longer than LogRecord::FUNCTION_SIZE - 1 are truncated */
+        void add(char const *function, ReturnCode rc, int severity, int64_t timestamp, size_t counter);
+        void addDropped(size_t dropped);
+        /* hands the buffered entries to the file, without flushing the file itself */
+        void flush();
+
+    private:
+        static const size_t SITE_SLOTS = 1024;
+        static const size_t POINTER_SLOTS = 256;
+        static const size_t BUFFER_SIZE = 4096;
+        /* the most one add() appends: the header, a site definition with a full-length name and the record */
+        static const size_t MAX_ENTRY = 80 + LogRecord::FUNCTION_SIZE;
+
+        LogEncoder(LogEncoder const&)            = delete;
+        LogEncoder& operator=(LogEncoder const&) = delete;
+
+        void reserve();
+        void putVarint(uint64_t value);
+        void putSigned(int64_t value);
+        size_t intern(char const *function);
+        void putRecord(LogEntry kind, char const *function, ReturnCode rc, int severity, int64_t timestamp, size_t counter);
+
+        FILE *file_;
+        bool headerPending_;
+        int64_t epoch_;
+        int64_t lastTimestamp_;
+        int64_t lastCounter_;
+        char sites_[SITE_SLOTS][LogRecord::FUNCTION_SIZE];
+        char const *pointers_[POINTER_SLOTS];
+        size_t pointerIds_[POINTER_SLOTS];
+        unsigned char buffer_[BUFFER_SIZE];
+        size_t used_;
+};
+
+/* Reads a binary stream back, the inverse of LogEncoder */
+class DLL_LOCAL_VISIBILITY LogDecoder {
+    public:
+        explicit LogDecoder(FILE *file);
+
+        /* RC_SUCCESS with the next record, its timestamp in microseconds since the epoch, or with dropped > 0
+         * for a dropped-records entry;
+         * RC_ELEM_NOT_FOUND at the end of the stream, RC_INVALID_PARAMS on malformed input */
+        ReturnCode next(LogRecord &record, size_t &dropped);
+
+    private:
+        static const size_t SITE_SLOTS = 1024;
+
+        LogDecoder(LogDecoder const&)            = delete;
+        LogDecoder& operator=(LogDecoder const&) = delete;
+
+        bool getVarint(uint64_t &value);
+        bool getSigned(int64_t &value);
+
+        FILE *file_;
+        bool headerRead_;
+        int64_t lastTimestamp_;
+        int64_t lastCounter_;
+        char sites_[SITE_SLOTS][LogRecord::FUNCTION_SIZE];
+};
+
+#endif //LOGCODEC_H
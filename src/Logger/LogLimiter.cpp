@@ -0,0 +1,80 @@
+#include "LogLimiter.h"
+#include "include/ILogger.h"
+#include <chrono>
+#include <cstring>
+
+std::atomic<size_t> LogLimiter::burst_(0);
+std::atomic<int64_t> LogLimiter::periodMs_(ILogger::RATE_PERIOD_MS);
+thread_local LogLimiter::Table LogLimiter::t_table;
+
+LogLimiter::Table::~Table() {
+    if (this->report != nullptr) {
+        for (size_t i = 0; i < SLOTS; ++i)
+            LogLimiter::summarize(this->entries[i], this->report);
+    }
+} //OK
+
+void LogLimiter::configure(size_t burst, size_t periodMs) {
+    LogLimiter::periodMs_.store((int64_t)periodMs, std::memory_order_relaxed);
+    LogLimiter::burst_.store(burst, std::memory_order_relaxed);
+} //OK
+
+int64_t LogLimiter::now() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+} //OK
+
+void LogLimiter::summarize(Entry &entry, Report report) {
+    if (entry.suppressed == 0)
+        return;
+    LogRecord summary;
+    memcpy(summary.function, entry.name, LogRecord::FUNCTION_SIZE);
+    summary.rc = entry.rc;
+    summary.severity = entry.severity;
+    summary.repeated = entry.suppressed;
+    summary.span = entry.lastSuppressed - entry.windowStart;
+    entry.suppressed = 0;
+    report(summary);
+} //OK
+
+bool LogLimiter::admit(char const *function, ReturnCode rc, int severity, Report report) {
+    size_t burst = LogLimiter::burst_.load(std::memory_order_relaxed);
+    if (burst == 0)
+        return true;
+
+    Table &table = LogLimiter::t_table;
+    table.report = report;
+    Entry &entry = table.entries[((size_t)function >> 4 ^ (size_t)function >> 12 ^ (size_t)rc) & (SLOTS - 1)];
+    if (entry.site != function || entry.rc != rc || strncmp(entry.name, function, LogRecord::FUNCTION_SIZE - 1) != 0) {
+        LogLimiter::summarize(entry, report);
+        entry.site = function;
+        strncpy(entry.name, function, LogRecord::FUNCTION_SIZE - 1);
+        entry.name[LogRecord::FUNCTION_SIZE - 1] = '\0';
+        entry.rc = rc;
+        entry.severity = severity;
+        entry.windowStart = LogLimiter::now();
+        entry.admitted = 1;
+        return true;
+    }
+    if (entry.admitted < burst) {
+        entry.admitted++;
+        return true;
+    }
+
+    /* the clock is only read once the burst is used up */
+    int64_t time = LogLimiter::now();
+    if (time - entry.windowStart >= LogLimiter::periodMs_.load(std::memory_order_relaxed)) {
+        LogLimiter::summarize(entry, report);
+        entry.windowStart = time;
+        entry.admitted = 1;
+        return true;
+    }
+    entry.suppressed++;
+    entry.lastSuppressed = time;
+    return false;
+} //OK
+
+void LogLimiter::flushLocal(Report report) {
+    Table &table = LogLimiter::t_table;
+    for (size_t i = 0; i < SLOTS; ++i)
+        LogLimiter::summarize(table.entries[i], report);
+} //OK
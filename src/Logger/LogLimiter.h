@@ -0,0 +1,54 @@
+#ifndef LOGLIMITER_H
+#define LOGLIMITER_H
+
+#include "LogQueue.h"
+#include <atomic>
+#include <cstddef> // size_t
+#include <cstdint>
+
+/* Rate limit per call site, kept by each thread without locks: within a period the first burst events of one
+ * (function, ReturnCode) pair pass and the rest are only counted. The count is reported as a summary record
+ * when the pair shows up again after the period, when another pair takes its table slot, on flushLocal, or
+ * when the thread exits. A call site is the message pointer, checked against the text it held first. */
+class DLL_LOCAL_VISIBILITY LogLimiter {
+    public:
+        /* receives the summaries, as records with repeated set */
+        typedef void (*Report)(LogRecord const &summary);
+
+        /* burst 0 lets every event pass */
+        static void configure(size_t burst, size_t periodMs);
+        /* whether the event is to be logged; may hand a summary to report first */
+        static bool admit(char const *function, ReturnCode rc, int severity, Report report);
+        /* reports what the calling thread has counted so far */
+        static void flushLocal(Report report);
+
+    private:
+        static const size_t SLOTS = 64;
+
+        struct Entry {
+            char const *site;
+            char name[LogRecord::FUNCTION_SIZE];
+            ReturnCode rc;
+            int severity;
+            /* milliseconds */
+            int64_t windowStart;
+            int64_t lastSuppressed;
+            size_t admitted;
+            size_t suppressed;
+        };
+
+        struct Table {
+            Entry entries[SLOTS];
+            Report report;
+            ~Table();
+        };
+
+        static void summarize(Entry &entry, Report report);
+        static int64_t now();
+
+        static std::atomic<size_t> burst_;
+        static std::atomic<int64_t> periodMs_;
+        static thread_local Table t_table;
+};
+
+#endif //LOGLIMITER_H
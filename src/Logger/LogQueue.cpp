@@ -0,0 +1,74 @@
+#include "LogQueue.h"
+#include <new>
+
+LogQueue *LogQueue::create(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity && size <= (static_cast<size_t>(-1) >> 1) / sizeof(Slot))
+        size *= 2;
+
+    Slot *slots = new(std::nothrow) Slot[size];
+    if (slots == nullptr)
+        return nullptr;
+    for (size_t i = 0; i < size; ++i)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+
+    LogQueue *queue = new(std::nothrow) LogQueue(slots, size - 1);
+    if (queue == nullptr)
+        delete[]slots;
+    return queue;
+} //OK
+
+LogQueue::LogQueue(Slot *slots, size_t mask) : slots_{slots}, mask_{mask}, pushPos_{0}, popPos_{0} {
+
+} //OK
+
+LogQueue::~LogQueue() {
+    delete[]this->slots_;
+    this->slots_ = nullptr;
+} //OK
+
+bool LogQueue::tryPush(LogRecord const &record) {
+    size_t pos = this->pushPos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = this->slots_[pos & this->mask_];
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (this->pushPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = this->pushPos_.load(std::memory_order_relaxed);
+        }
+    }
+} //OK
+
+bool LogQueue::tryPop(LogRecord &record) {
+    size_t pos = this->popPos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = this->slots_[pos & this->mask_];
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - (pos + 1));
+        if (diff == 0) {
+            if (this->popPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                record = slot.record;
+                slot.sequence.store(pos + this->mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = this->popPos_.load(std::memory_order_relaxed);
+        }
+    }
+} //OK
+
+size_t LogQueue::getPushed() const {
+    return this->pushPos_.load(std::memory_order_acquire);
+} //OK
+
+size_t LogQueue::getPopped() const {
+    return this->popPos_.load(std::memory_order_acquire);
+} //OK
@@ -0,0 +1,62 @@
+#ifndef LOGQUEUE_H
+#define LOGQUEUE_H
+
+#include "../Util/ReturnCode.h"
+#include "../Util/Export.h"
+#include <atomic>
+#include <cstddef> // size_t
+#include <cstdint>
+
+/* what log() hands to the background writer; the function name is copied, truncated if needed */
+struct LogRecord {
+    static const size_t FUNCTION_SIZE = 48;
+
+    size_t counter;
+    /* microseconds on the logger's monotonic clock, since the epoch once decoded */
+    int64_t timestamp;
+    ReturnCode rc;
+    /* an ILogger::Severity */
+    int severity;
+    /* for a summary of suppressed repeats their number and the milliseconds they spanned, 0 otherwise */
+    size_t repeated;
+    int64_t span;
+    char function[FUNCTION_SIZE];
+};
+
+/* Bounded lock-free queue of log records, any number of threads pushing and popping (bounded MPMC queue of
+ * D. Vyukov): each slot carries a sequence number telling whether it is free for the next push or the next pop */
+class DLL_LOCAL_VISIBILITY LogQueue {
+    public:
+        /* capacity is rounded up to a power of two; nullptr when it cannot be allocated */
+        static LogQueue* create(size_t capacity);
+        ~LogQueue();
+
+        /* false when the queue is full or empty, respectively */
+        bool tryPush(LogRecord const& record);
+        bool tryPop(LogRecord& record);
+        /* number of pushes started so far, and of pops */
+        size_t getPushed() const;
+        size_t getPopped() const;
+
+    private:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            LogRecord record;
+        };
+
+        LogQueue(Slot* slots, size_t mask);
+        LogQueue(LogQueue const&)            = delete;
+        LogQueue& operator=(LogQueue const&) = delete;
+
+        static const size_t CACHE_LINE = 64;
+
+        Slot* slots_;
+        size_t mask_;
+        /* padded apart, as producers and the writer update them concurrently */
+        char padPush_[CACHE_LINE];
+        std::atomic<size_t> pushPos_;
+        char padPop_[CACHE_LINE];
+        std::atomic<size_t> popPos_;
+};
+
+#endif //LOGQUEUE_H
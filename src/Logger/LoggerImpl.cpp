@@ -1,126 +1,408 @@
 #include "include/ILogger.h"
-#include <vector>
+#include "LogCodec.h"
+#include "LogLimiter.h"
+#include "LogQueue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <cstdlib>
+#include <new>
 #include <cstdio>
+#include <ctime>
 
 namespace {
+    /* The log file, formatting and asynchronous writer behind every LoggerImpl handle. Created on the first write
+     * or configuration call and never destroyed, so it outlives static objects that log while being torn down;
+     * it is flushed when the last client releases its handle and at exit. */
+    class LogSink {
+        public:
+            /* nullptr when it cannot be allocated */
+            static LogSink *instance();
+            /* flushes the sink if it was ever created */
+            static void flushCreated();
+
+            void log(char const *message, ReturnCode rc, ILogger::Severity severity);
+            /* writes a summary of suppressed repeats, numbered like any other record */
+            void logRepeated(LogRecord const &summary);
+            ReturnCode setLogFile(char const *logFileName, ILogger::Format format);
+            ReturnCode setAsync(bool async, size_t capacity, ILogger::Overflow overflow);
+            void flush();
+
+        private:
+            /* how long the idle writer sleeps before looking at the queue again */
+            static const int WRITER_PERIOD_MS = 2;
+            static const size_t LINE_SIZE = 256;
+
+            static std::atomic<size_t> msgCounter_;
+            static std::atomic<LogSink *> created_;
+
+            static LogSink *create();
+            /* the timestamp of a record, microseconds on a monotonic clock */
+            static int64_t now();
+            /* microseconds since the epoch at now() == 0, taken once per binary file */
+            static int64_t epoch();
+
+            LogSink();
+            LogSink(LogSink const&)            = delete;
+            LogSink& operator=(LogSink const&) = delete;
+
+            void push(LogRecord const &record);
+            /* the print functions are called under mutex_ */
+            void print(size_t counter, char const *function, ReturnCode rc);
+            void printRepeated(LogRecord const &summary);
+            void printDropped(size_t dropped);
+            /* line is LINE_SIZE chars holding length of text, or an error when length is negative */
+            void writeLine(char *line, int length);
+            /* writes queued records until stop_ is set and the queue is empty */
+            void writerLoop();
+            void stopWriter();
+
+            /* mutex_ guards logFile_, format_ and encoder_: setLogFile swaps them while records are written */
+            FILE *logFile_;
+            /* in binary format records go through encoder_ */
+            ILogger::Format format_;
+            LogEncoder encoder_;
+
+            /* asynchronous mode, active while queue_ is not null */
+            LogQueue *queue_;
+            ILogger::Overflow overflow_;
+            std::thread writer_;
+            std::mutex mutex_;
+            std::condition_variable wakeup_;
+            std::condition_variable idle_;
+            bool busy_;
+            bool stop_;
+            std::atomic<size_t> dropped_;
+    };
+    std::atomic<size_t> LogSink::msgCounter_(0);
+    std::atomic<LogSink *> LogSink::created_(nullptr);
+    const int LogSink::WRITER_PERIOD_MS;
+
+    /* The one handle createLogger gives out: registering a client only counts it, and every call goes
+     * to the LogSink, so handles are cheap to take and release from any thread */
     class LoggerImpl : public ILogger {
         public:
             static ILogger *addClient(void *client);
 
             void releaseLogger(void *client) override;
-            void log(char const *message, ReturnCode rc) override;
-            ReturnCode setLogFile(char const *logFileName) override;
-
-            LoggerImpl();
-            ~LoggerImpl();
+            void log(char const *message, ReturnCode rc, Severity severity) override;
+            ReturnCode setLogFile(char const *logFileName, Format format) override;
+            ReturnCode setAsync(bool async, size_t capacity, Overflow overflow) override;
+            void flush() override;
 
         private:
-            static const char *msgMask_;
-            static size_t msgCounter_;
+            static std::atomic<size_t> clients_;
 
-            static LoggerImpl *instance_;
+            static void reportRepeated(LogRecord const &summary);
 
-            std::vector<void *> clients_;
-            FILE *logFile_;
+            LoggerImpl() = default;
     };
-    LoggerImpl *LoggerImpl::instance_ = nullptr;
-    const char *LoggerImpl::msgMask_ = "%d.--Function:[%s]--ReturnCode:[%d]--Message:[%s]";
-    size_t LoggerImpl::msgCounter_ = 0;
+    std::atomic<size_t> LoggerImpl::clients_(0);
 }
 
-static char const* msgDefaults[(size_t)ReturnCode::RC_UNKNOWN + 1] = {
-        "It's OK",
-        "Can not allocate memory",
-        "Null pointer passed as argument",
-        "Degenerate mathematical object",
-        "Mismatch of dimensions of mathematical objects",
-        "NAN value passed as argument",
-        "Index exceeds the number of elements in container",
-        "Can not open file",
-        "This element not found",
-        "Invalid arguments passed",
-        "Object requires initialization",
-        "Uknown return"
-};
-
-
 void LoggerImpl::releaseLogger(void *client) {
     if (client == nullptr) {
         //METALOG
         return;
     }
 
-    std::vector<void *>::iterator it = this->clients_.begin();
-    while (*it != client && ++it != this->clients_.end());
+    if (LoggerImpl::clients_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        LogLimiter::flushLocal(LoggerImpl::reportRepeated);
+        LogSink::flushCreated();
+    }
+} //OK, but LOG?
 
-    this->clients_.erase(it); //this or instance_?
+void LoggerImpl::log(const char *message, ReturnCode rc, Severity severity) {
+    if (!ILogger::isEnabled(severity))
+        return;
+    if (message == nullptr)
+        message = __FUNCTION__;
+    if (!LogLimiter::admit(message, rc, static_cast<int>(severity), LoggerImpl::reportRepeated))
+        return;
+    LogSink *sink = LogSink::instance();
+    if (sink != nullptr)
+        sink->log(message, rc, severity);
+} //OK
 
-    if (this->clients_.empty()) {
-        delete LoggerImpl::instance_;
-        LoggerImpl::instance_ = nullptr;
+ReturnCode LoggerImpl::setLogFile(const char *logFileName, Format format) {
+    LogSink *sink = LogSink::instance();
+    if (sink == nullptr) {
+        //METALOG
+        return ReturnCode::RC_NO_MEM;
     }
-} //OK, but LOG?
+    return sink->setLogFile(logFileName, format);
+} //OK
+
+ReturnCode LoggerImpl::setAsync(bool async, size_t capacity, Overflow overflow) {
+    LogSink *sink = LogSink::instance();
+    if (sink == nullptr) {
+        //METALOG
+        return ReturnCode::RC_NO_MEM;
+    }
+    return sink->setAsync(async, capacity, overflow);
+} //OK
+
+void LoggerImpl::flush() {
+    LogLimiter::flushLocal(LoggerImpl::reportRepeated);
+    LogSink::flushCreated();
+} //OK
+
+void LoggerImpl::reportRepeated(LogRecord const &summary) {
+    LogSink *sink = LogSink::instance();
+    if (sink != nullptr)
+        sink->logRepeated(summary);
+} //OK
+
+ILogger *LoggerImpl::addClient(void *client) {
+    if (client == nullptr) {
+        //METALOG
+        return nullptr;
+    }
+
+    static LoggerImpl *handle = new(std::nothrow) LoggerImpl();
+    if (handle == nullptr) {
+        //METALOG
+        return nullptr;
+    }
+    LoggerImpl::clients_.fetch_add(1, std::memory_order_relaxed);
+    return handle;
+} //OK
+
+LogSink *LogSink::instance() {
+    static LogSink *sink = LogSink::create();
+    return sink;
+} //OK
+
+LogSink *LogSink::create() {
+    LogSink *sink = new(std::nothrow) LogSink();
+    if (sink == nullptr)
+        return nullptr;
+    LogSink::created_.store(sink, std::memory_order_release);
+    std::atexit(LogSink::flushCreated);
+    return sink;
+} //OK
 
-void LoggerImpl::log(const char *message, ReturnCode rc) {
-    LoggerImpl::msgCounter_++;
+void LogSink::flushCreated() {
+    LogSink *sink = LogSink::created_.load(std::memory_order_acquire);
+    if (sink != nullptr)
+        sink->flush();
+} //OK
 
+void LogSink::log(const char *message, ReturnCode rc, ILogger::Severity severity) {
+    size_t counter = LogSink::msgCounter_.fetch_add(1, std::memory_order_relaxed) + 1;
     if (message == NULL)
-        fprintf(this->logFile_, LoggerImpl::msgMask_, LoggerImpl::msgCounter_, __FUNCTION__, rc, msgDefaults[(size_t)rc]);
-    else
-        fprintf(this->logFile_, LoggerImpl::msgMask_, LoggerImpl::msgCounter_, message, rc, msgDefaults[(size_t)rc]);
-    fprintf(this->logFile_, "\n");
+        message = __FUNCTION__;
+
+    if (this->queue_ == nullptr) {
+        /* setLogFile may swap the file and format under mutex_ at any time */
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->format_ == ILogger::Format::FORMAT_TEXT)
+            this->print(counter, message, rc);
+        else
+            this->encoder_.add(message, rc, static_cast<int>(severity), LogSink::now(), counter);
+        return;
+    }
+
+    int64_t timestamp = LogSink::now();
+
+    LogRecord record;
+    record.counter = counter;
+    record.timestamp = timestamp;
+    record.rc = rc;
+    record.severity = static_cast<int>(severity);
+    strncpy(record.function, message, LogRecord::FUNCTION_SIZE - 1);
+    record.function[LogRecord::FUNCTION_SIZE - 1] = '\0';
+    record.repeated = 0;
+    record.span = 0;
+    this->push(record);
 } //OK, but LOG
 
-ReturnCode LoggerImpl::setLogFile(const char *logFileName) {
+void LogSink::logRepeated(LogRecord const &summary) {
+    LogRecord record = summary;
+    record.counter = LogSink::msgCounter_.fetch_add(1, std::memory_order_relaxed) + 1;
+    record.timestamp = LogSink::now();
+
+    if (this->queue_ == nullptr) {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->format_ == ILogger::Format::FORMAT_TEXT)
+            this->printRepeated(record);
+        else
+            this->encoder_.add(record);
+        return;
+    }
+    this->push(record);
+} //OK
+
+int64_t LogSink::now() {
+#ifdef CLOCK_MONOTONIC_COARSE
+    /* a few milliseconds per tick, read without a system call and at a fraction of the cost of a precise clock */
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+    return (int64_t)time.tv_sec * 1000000 + time.tv_nsec / 1000;
+#else
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+} //OK
+
+int64_t LogSink::epoch() {
+    int64_t system = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return system - LogSink::now();
+} //OK
+
+void LogSink::push(LogRecord const &record) {
+    while (!this->queue_->tryPush(record)) {
+        if (this->overflow_ == ILogger::Overflow::OVERFLOW_DROP) {
+            this->dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (this->overflow_ == ILogger::Overflow::OVERFLOW_OVERWRITE) {
+            LogRecord oldest;
+            if (this->queue_->tryPop(oldest))
+                this->dropped_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            this->wakeup_.notify_one();
+            std::this_thread::yield();
+        }
+    }
+} //OK
+
+void LogSink::print(size_t counter, char const *function, ReturnCode rc) {
+    char line[LogSink::LINE_SIZE];
+    this->writeLine(line, formatLogLine(line, LogSink::LINE_SIZE - 1, counter, function, rc));
+} //OK
+
+void LogSink::printRepeated(LogRecord const &summary) {
+    char line[LogSink::LINE_SIZE];
+    this->writeLine(line, formatRepeatedLine(line, LogSink::LINE_SIZE - 1, summary));
+} //OK
+
+void LogSink::writeLine(char *line, int length) {
+    if (length < 0)
+        return;
+    size_t end = (size_t)length < LogSink::LINE_SIZE - 2 ? (size_t)length : LogSink::LINE_SIZE - 2;
+    line[end] = '\n';
+    line[end + 1] = '\0';
+    fputs(line, this->logFile_);
+} //OK
+
+void LogSink::printDropped(size_t dropped) {
+    char line[LogSink::LINE_SIZE];
+    if (formatDroppedLine(line, sizeof(line), dropped) >= 0)
+        fprintf(this->logFile_, "%s\n", line);
+} //OK
+
+void LogSink::writerLoop() {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    for (;;) {
+        bool stopping = this->stop_;
+        this->busy_ = true;
+        LogRecord record;
+        bool binary = this->format_ == ILogger::Format::FORMAT_BINARY;
+        while (this->queue_->tryPop(record)) {
+            if (binary)
+                this->encoder_.add(record);
+            else if (record.repeated > 0)
+                this->printRepeated(record);
+            else
+                this->print(record.counter, record.function, record.rc);
+        }
+        size_t dropped = this->dropped_.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0 && binary)
+            this->encoder_.addDropped(dropped);
+        else if (dropped > 0)
+            this->printDropped(dropped);
+        if (binary)
+            this->encoder_.flush();
+        this->busy_ = false;
+        this->idle_.notify_all();
+
+        if (stopping)
+            return;
+        this->wakeup_.wait_for(lock, std::chrono::milliseconds(LogSink::WRITER_PERIOD_MS));
+    }
+} //OK
+
+void LogSink::stopWriter() {
+    if (this->queue_ == nullptr)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stop_ = true;
+    }
+    this->wakeup_.notify_one();
+    this->writer_.join();
+    delete this->queue_;
+    this->queue_ = nullptr;
+} //OK
+
+ReturnCode LogSink::setAsync(bool async, size_t capacity, ILogger::Overflow overflow) {
+    if (async && (capacity == 0 || (overflow != ILogger::Overflow::OVERFLOW_DROP && overflow != ILogger::Overflow::OVERFLOW_BLOCK &&
+                                    overflow != ILogger::Overflow::OVERFLOW_OVERWRITE))) {
+        //METALOG
+        return ReturnCode::RC_INVALID_PARAMS;
+    }
+
+    this->stopWriter();
+    if (!async)
+        return ReturnCode::RC_SUCCESS;
+
+    this->queue_ = LogQueue::create(capacity);
+    if (this->queue_ == nullptr) {
+        //METALOG
+        return ReturnCode::RC_NO_MEM;
+    }
+    this->overflow_ = overflow;
+    this->stop_ = false;
+    this->writer_ = std::thread(&LogSink::writerLoop, this);
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+void LogSink::flush() {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    if (this->queue_ != nullptr) {
+        size_t target = this->queue_->getPushed();
+        this->wakeup_.notify_one();
+        while (this->busy_ || this->queue_->getPopped() < target)
+            this->idle_.wait(lock);
+    }
+    this->encoder_.flush();
+    fflush(this->logFile_);
+} //OK
+
+ReturnCode LogSink::setLogFile(const char *logFileName, ILogger::Format format) {
     if (logFileName == nullptr) {
         //METALOG
         return ReturnCode::RC_NULL_PTR;
     }
+    if (format != ILogger::Format::FORMAT_TEXT && format != ILogger::Format::FORMAT_BINARY) {
+        //METALOG
+        return ReturnCode::RC_INVALID_PARAMS;
+    }
 
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->encoder_.flush();
     if (this->logFile_ != nullptr && this->logFile_ != stdout) {
         fflush(this->logFile_);
         fclose(this->logFile_);
         this->logFile_ = nullptr;
     }
 
-    this->logFile_ = fopen(logFileName, "w");
+    bool binary = format == ILogger::Format::FORMAT_BINARY;
+    this->logFile_ = fopen(logFileName, binary ? "wb" : "w");
     if (this->logFile_ == nullptr) {
         //METALOG
         this->logFile_ = stdout;
+        this->format_ = ILogger::Format::FORMAT_TEXT;
         return ReturnCode::RC_OPEN_FILE;
     }
+    this->format_ = format;
+    this->encoder_.reset(this->logFile_, LogSink::epoch());
     return ReturnCode::RC_SUCCESS;
 } //OK, but LOG?
 
-ILogger *LoggerImpl::addClient(void *client) {
-    if (client == nullptr) {
-        //METALOG
-        return nullptr;
-    }
-
-    if (LoggerImpl::instance_ == nullptr) {
-        LoggerImpl::instance_ = new(std::nothrow) LoggerImpl();
-        if (LoggerImpl::instance_ == nullptr) {
-            //METALOG
-            return nullptr;
-        }
-        LoggerImpl::instance_->logFile_ = stdout;
-    }
-
-    LoggerImpl::instance_->clients_.push_back(client);
-    return LoggerImpl::instance_;
-} //OK, but LOG?
+LogSink::LogSink() : logFile_{stdout}, format_{ILogger::Format::FORMAT_TEXT}, queue_{nullptr}, overflow_{ILogger::Overflow::OVERFLOW_BLOCK}, busy_{false}, stop_{false}, dropped_{0} {
 
-LoggerImpl::LoggerImpl() : logFile_{nullptr} {
-
-} //OK
-
-LoggerImpl::~LoggerImpl() {
-    if (this->logFile_ == nullptr)
-        return;
-
-    fflush(this->logFile_);
-    if (this->logFile_ != stdout)
-        fclose(this->logFile_);
-    this->logFile_ = nullptr;
 } //OK
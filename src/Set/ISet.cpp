@@ -1,5 +1,6 @@
 #include "ISet.h"
 #include "SetImpl.cpp"
+#include "../Vector/include/IVectorBatch.h"
 
 ISet::~ISet() {}
 
@@ -208,3 +209,41 @@ ISet *ISet::intersection(const ISet *set1, const ISet *set2, IVector::Norm norm,
     return intsct;
 } //OK
 
+/* the vectors of set copied row by row into one batch */
+static IVectorBatch *gatherBatch(ISet const *set, ILogger *logger) {
+    std::vector<IVector *> vectors(set->getSize(), nullptr);
+    bool gathered = true;
+    for (size_t i = 0; gathered && i < vectors.size(); ++i)
+        gathered = set->get(vectors[i], i) == ReturnCode::RC_SUCCESS && vectors[i] != nullptr;
+
+    IVectorBatch *batch = gathered ? IVectorBatch::createBatch(vectors.data(), vectors.size(), logger) : nullptr;
+    for (std::vector<IVector *>::iterator it = vectors.begin(); it < vectors.end(); ++it)
+        delete *it;
+    return batch;
+} //OK
+
+ReturnCode ISet::distances(const ISet *set1, const ISet *set2, IVector::Norm norm, double *matrix, ILogger *logger) {
+    if (set1 == nullptr || set2 == nullptr || matrix == nullptr) {
+        SETLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (set1->getSize() == 0 || set2->getSize() == 0)
+        return ReturnCode::RC_SUCCESS;
+    if (set1->getDim() != set2->getDim()) {
+        SETLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+
+    IVectorBatch *batch1 = gatherBatch(set1, logger);
+    IVectorBatch *batch2 = batch1 != nullptr ? gatherBatch(set2, logger) : nullptr;
+    if (batch2 == nullptr) {
+        SETLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        delete batch1;
+        return ReturnCode::RC_NO_MEM;
+    }
+
+    ReturnCode rc = IVectorBatch::distances(batch1, batch2, norm, matrix, logger);
+    delete batch1;
+    delete batch2;
+    return rc;
+} //OK
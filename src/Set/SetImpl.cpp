@@ -3,9 +3,10 @@
 #include "ISet.h"
 
 #define MSG_DEFAULT __FUNCTION__
-#define SETLOG(logger, msg, rc)\
-if (logger != nullptr) {\
-    logger->log(msg, rc);\
+#define SETLOG(logger, msg, rc) SETLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define SETLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
 }
 
 namespace {
@@ -32,6 +33,14 @@ namespace {
     };
 }
 
+/* relative slack covering rounding in the two norm computations */
+static const double NORM_PRUNE_SLACK = 1e-9;
+
+/* reverse triangle inequality: |norm1 - norm2| beyond tolerance proves the vectors are not equal without comparing them */
+static bool isFarByNorm(double norm1, double norm2, double tolerance) {
+    return std::fabs(norm1 - norm2) - tolerance > NORM_PRUNE_SLACK * (norm1 + norm2);
+} //OK
+
 SetImpl::SetImpl() : dim_{0} {
     this->logger_ = ILogger::createLogger(this);
 } //OK
@@ -74,11 +83,17 @@ ReturnCode SetImpl::insert(const IVector *vector, IVector::Norm norm, double tol
         return ReturnCode::RC_WRONG_DIM;
 
 
+    double vecNorm = vector->norm(norm);
     bool is_in = false;
     ReturnCode rc;
     std::vector<IVector *>::const_iterator it = this->data_.begin();
     do {
-        rc = IVector::equals(*it, vector, norm, tolerance, is_in, this->logger_);
+        if (isFarByNorm((*it)->norm(norm), vecNorm, tolerance)) {
+            is_in = false;
+            rc = ReturnCode::RC_SUCCESS;
+        } else {
+            rc = IVector::equals(*it, vector, norm, tolerance, is_in, this->logger_);
+        }
     } while (!is_in && ++it != this->data_.end());
 
     if (rc != ReturnCode::RC_SUCCESS)
@@ -105,11 +120,14 @@ ReturnCode SetImpl::erase(const IVector *vector, IVector::Norm norm, double tole
     if (tolerance < .0)
         return ReturnCode::RC_INVALID_PARAMS;
 
+    double vecNorm = vector->norm(norm);
     bool is_equal;
     bool is_in = false;
     ReturnCode rc = ReturnCode::RC_SUCCESS;
     for (std::vector<IVector *>::iterator it = this->data_.begin(); rc == ReturnCode::RC_SUCCESS && it < this->data_.end();) {
-        rc = IVector::equals(*it, vector, norm, tolerance, is_equal, this->logger_);
+        is_equal = false;
+        if (!isFarByNorm((*it)->norm(norm), vecNorm, tolerance))
+            rc = IVector::equals(*it, vector, norm, tolerance, is_equal, this->logger_);
         if (is_equal) {
             delete *it;
             this->data_.erase(it);
@@ -171,11 +189,17 @@ ReturnCode SetImpl::find(const IVector *vector, IVector::Norm norm, double toler
     if (tolerance < 0)
         return ReturnCode::RC_INVALID_PARAMS;
 
+    double vecNorm = vector->norm(norm);
     bool is_in = false;
     ReturnCode rc;
     std::vector<IVector *>::const_iterator it = this->data_.begin();
     do {
-        rc = IVector::equals(*it, vector, norm, tolerance, is_in, this->logger_);
+        if (isFarByNorm((*it)->norm(norm), vecNorm, tolerance)) {
+            is_in = false;
+            rc = ReturnCode::RC_SUCCESS;
+        } else {
+            rc = IVector::equals(*it, vector, norm, tolerance, is_in, this->logger_);
+        }
     } while (!is_in && ++it != this->data_.end());
 
     if (rc != ReturnCode::RC_SUCCESS)
@@ -14,6 +14,8 @@ class DECLSPEC ISet {
         static ISet* difference(ISet const* minuend, ISet const* subtrahend, IVector::Norm norm, double tolerance, ILogger* logger = nullptr);
         static ISet* symmetricDifference(ISet const* set1, ISet const* set2, IVector::Norm norm, double tolerance, ILogger* logger = nullptr);
         static ISet* intersection(ISet const* set1, ISet const* set2, IVector::Norm norm, double tolerance, ILogger* logger = nullptr);
+        /* matrix[i * set2->getSize() + j] = distance between elements i of set1 and j of set2, see IVectorBatch::distances */
+        static ReturnCode distances(ISet const* set1, ISet const* set2, IVector::Norm norm, double* matrix, ILogger* logger = nullptr);
 
         virtual ReturnCode insert(IVector const* vector, IVector::Norm norm, double tolerance) = 0;
         virtual ReturnCode erase(IVector const* vector, IVector::Norm norm, double tolerance)  = 0;
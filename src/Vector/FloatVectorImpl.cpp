@@ -0,0 +1,172 @@
+#include "IVector.h"
+#include <cmath>
+#include <new>
+#include <limits>
+
+#define MSG_DEFAULT __FUNCTION__
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
+}
+
+namespace {
+    /* Coordinates stored as float; the interface stays double and reductions accumulate in double */
+    class FloatVectorImpl : public IVector {
+        public:
+            IVector *clone() const override;
+            ReturnCode setCoord(size_t index, double value) const override;
+            double getCoord(size_t index) const override;
+            double norm(Norm norm) const override;
+            size_t getDim() const override;
+            double const *getData() const override;
+            double *getData() override;
+            ReturnCode getCoords(size_t begin, size_t count, double *dst) const override;
+            ReturnCode setCoords(size_t begin, size_t count, double const *src) const override;
+
+            /* header and coordinates share one heap allocation; coordinates are left uninitialised */
+            static FloatVectorImpl *create(size_t dim);
+            static void operator delete(void *ptr);
+
+            ~FloatVectorImpl();
+
+        private:
+            FloatVectorImpl(size_t dim, float *data);
+
+            size_t dim_;
+            float *data_;
+            ILogger *logger_;
+    };
+}
+
+FloatVectorImpl *FloatVectorImpl::create(size_t dim) {
+    if (dim > (std::numeric_limits<size_t>::max() - sizeof(FloatVectorImpl)) / sizeof(float))
+        return nullptr;
+
+    void *block = ::operator new(sizeof(FloatVectorImpl) + dim * sizeof(float), std::nothrow);
+    if (block == nullptr)
+        return nullptr;
+
+    FloatVectorImpl *vec = static_cast<FloatVectorImpl *>(block);
+    return new(vec) FloatVectorImpl(dim, reinterpret_cast<float *>(vec + 1));
+} //OK
+
+void FloatVectorImpl::operator delete(void *ptr) {
+    ::operator delete(ptr);
+} //OK
+
+FloatVectorImpl::FloatVectorImpl(size_t dim, float *data) : dim_{dim}, data_{data} {
+    this->logger_ = ILogger::createLogger(this);
+} //OK
+
+FloatVectorImpl::~FloatVectorImpl() {
+    this->data_ = nullptr;
+    if (this->logger_ != nullptr)
+        this->logger_->releaseLogger(this);
+} //OK
+
+IVector *FloatVectorImpl::clone() const {
+    FloatVectorImpl *cloned = FloatVectorImpl::create(this->dim_);
+    if (cloned == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    for (size_t i = 0; i < this->dim_; ++i)
+        cloned->data_[i] = this->data_[i];
+    return cloned;
+} //OK
+
+ReturnCode FloatVectorImpl::setCoord(size_t index, double value) const {
+    if (index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    if (std::isnan(value)) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+    this->data_[index] = static_cast<float>(value);
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+double FloatVectorImpl::getCoord(size_t index) const {
+    if (index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return NAN;
+    }
+    return this->data_[index];
+} //OK
+
+double FloatVectorImpl::norm(IVector::Norm norm) const {
+    double vec_norm = 0;
+    switch (norm) {
+        case IVector::Norm::NORM_1:
+            for (size_t i = 0; i < this->dim_; ++i)
+                vec_norm += std::fabs(static_cast<double>(this->data_[i]));
+            break;
+        case IVector::Norm::NORM_2:
+            for (size_t i = 0; i < this->dim_; ++i)
+                vec_norm += static_cast<double>(this->data_[i]) * this->data_[i];
+            vec_norm = std::sqrt(vec_norm);
+            break;
+        case IVector::Norm::NORM_INF:
+            for (size_t i = 0; i < this->dim_; ++i) {
+                double coord = std::fabs(static_cast<double>(this->data_[i]));
+                vec_norm = coord > vec_norm ? coord : vec_norm;
+            }
+            break;
+        default:
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+            vec_norm = std::nan("1");
+            break;
+    }
+    return vec_norm;
+} //OK
+
+size_t FloatVectorImpl::getDim() const {
+    return this->dim_;
+} //OK
+
+double const *FloatVectorImpl::getData() const {
+    return nullptr;
+} //OK
+
+double *FloatVectorImpl::getData() {
+    return nullptr;
+} //OK
+
+ReturnCode FloatVectorImpl::getCoords(size_t begin, size_t count, double *dst) const {
+    if (dst == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    float const *src = this->data_ + begin;
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = src[i];
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode FloatVectorImpl::setCoords(size_t begin, size_t count, double const *src) const {
+    if (src == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (std::isnan(src[i])) {
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+            return ReturnCode::RC_NAN;
+        }
+    }
+    float *dst = this->data_ + begin;
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<float>(src[i]);
+    return ReturnCode::RC_SUCCESS;
+} //OK
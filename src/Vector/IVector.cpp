@@ -1,9 +1,59 @@
 #include "IVector.h"
+#include "ParallelKernels.h"
+#include "VectorHash.h"
 #include "VectorImpl.cpp"
+#include "VectorViewImpl.cpp"
+#include "FloatVectorImpl.cpp"
+#include "SparseVectorImpl.cpp"
 
 IVector::~IVector() {}
 
-IVector *IVector::createVector(size_t dim, double *data, ILogger *logger) {
+const size_t IVector::PARALLEL_MIN_DIM;
+
+/* coordinates [begin, begin + count) of vec: straight from data when vec is contiguous, otherwise copied into scratch */
+static double const *blockOf(IVector const *vec, double const *data, size_t begin, size_t count, double *scratch) {
+    if (data != nullptr)
+        return data + begin;
+    vec->getCoords(begin, count, scratch);
+    return scratch;
+} //OK
+
+/* a * x + b * y as a new sparse vector */
+static IVector *sparseLincomb(double a, SparseVectorImpl const *x, double b, SparseVectorImpl const *y, ILogger *logger) {
+    SparseVectorImpl *result = SparseVectorImpl::lincomb(a, x, b, y);
+    if (result == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+    }
+    return result;
+} //OK
+
+/* mutable coordinates of dst for writes within the call, without the lasting effect getData() has on a VectorImpl */
+static double *writableData(IVector *dst) {
+    VectorImpl *impl = dynamic_cast<VectorImpl *>(dst);
+    return impl != nullptr ? impl->writeData() : dst->getData();
+} //OK
+
+/* y += a * x without validation; the generic path stops at the first coordinate setCoord rejects */
+static ReturnCode axpyUnchecked(IVector *y, double a, IVector const *x) {
+    double *dataY = writableData(y);
+    double const *dataX = x->getData();
+    if (dataY != nullptr && dataX != nullptr) {
+        kernelsFor(y->getDim()).axpy(dataY, a, dataX, y->getDim());
+        return ReturnCode::RC_SUCCESS;
+    }
+    SparseVectorImpl const *sparseX = dynamic_cast<SparseVectorImpl const *>(x);
+    if (dataY != nullptr && sparseX != nullptr) {
+        sparseX->axpyInto(dataY, a);
+        return ReturnCode::RC_SUCCESS;
+    }
+
+    ReturnCode rc = ReturnCode::RC_SUCCESS;
+    for (size_t i = 0; rc == ReturnCode::RC_SUCCESS && i < y->getDim(); ++i)
+        rc = y->setCoord(i, y->getCoord(i) + a * x->getCoord(i));
+    return rc;
+} //OK
+
+IVector *IVector::createVector(IVectorArena *arena, size_t dim, double *data, ILogger *logger) {
     if (dim == 0) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
         return nullptr;
@@ -19,23 +69,16 @@ IVector *IVector::createVector(size_t dim, double *data, ILogger *logger) {
         }
     }
 
-    double *clonedData = new(std::nothrow)double[dim];
-    if (clonedData == nullptr) {
-        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        return nullptr;
-    }
-    for (size_t i = 0; i < dim; i++)
-        clonedData[i] = data[i];
-
-    IVector *vec = new(std::nothrow)VectorImpl(dim, clonedData);
+    VectorImpl *vec = VectorImpl::create(dim, arena, logger);
     if (vec == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        delete[]clonedData;
+        return nullptr;
     }
+    std::memcpy(vec->writeData(), data, dim * sizeof(double));
     return vec;
 } //OK
 
-IVector *IVector::add(IVector const *addend1, IVector const *addend2, ILogger *logger) {
+IVector *IVector::add(IVectorArena *arena, IVector const *addend1, IVector const *addend2, ILogger *logger) {
     if (addend1 == nullptr || addend2 == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
         return nullptr;
@@ -45,24 +88,22 @@ IVector *IVector::add(IVector const *addend1, IVector const *addend2, ILogger *l
         return nullptr;
     }
 
-    double *coords = new(std::nothrow)double[addend1->getDim()];
-    if (coords == nullptr) {
-        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        return nullptr;
-    }
-    for (size_t i = 0; i < addend1->getDim(); ++i) {
-        coords[i] = addend1->getCoord(i) + addend2->getCoord(i);
-    }
+    SparseVectorImpl const *sparse1 = dynamic_cast<SparseVectorImpl const *>(addend1);
+    SparseVectorImpl const *sparse2 = dynamic_cast<SparseVectorImpl const *>(addend2);
+    if (arena == nullptr && sparse1 != nullptr && sparse2 != nullptr)
+        return sparseLincomb(1.0, sparse1, 1.0, sparse2, logger);
 
-    IVector *sum = new(std::nothrow)VectorImpl(addend1->getDim(), coords);
+    VectorImpl *sum = VectorImpl::create(addend1->getDim(), arena, logger);
     if (sum == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        delete[]coords;
+        return nullptr;
     }
+    addend1->getCoords(0, addend1->getDim(), sum->writeData());
+    axpyUnchecked(sum, 1.0, addend2);
     return sum;
 } //OK
 
-IVector *IVector::sub(IVector const *minuend, IVector const *subtrahend, ILogger *logger) {
+IVector *IVector::sub(IVectorArena *arena, IVector const *minuend, IVector const *subtrahend, ILogger *logger) {
     if (minuend == nullptr || subtrahend == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
         return nullptr;
@@ -72,24 +113,22 @@ IVector *IVector::sub(IVector const *minuend, IVector const *subtrahend, ILogger
         return nullptr;
     }
 
-    double *coords = new(std::nothrow)double[minuend->getDim()];
-    if (coords == nullptr) {
-        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        return nullptr;
-    }
-    for (size_t i = 0; i < minuend->getDim(); ++i) {
-        coords[i] = minuend->getCoord(i) - subtrahend->getCoord(i);
-    }
+    SparseVectorImpl const *sparse1 = dynamic_cast<SparseVectorImpl const *>(minuend);
+    SparseVectorImpl const *sparse2 = dynamic_cast<SparseVectorImpl const *>(subtrahend);
+    if (arena == nullptr && sparse1 != nullptr && sparse2 != nullptr)
+        return sparseLincomb(1.0, sparse1, -1.0, sparse2, logger);
 
-    IVector *diff = new(std::nothrow)VectorImpl(minuend->getDim(), coords);
+    VectorImpl *diff = VectorImpl::create(minuend->getDim(), arena, logger);
     if (diff == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        delete[]coords;
+        return nullptr;
     }
+    minuend->getCoords(0, minuend->getDim(), diff->writeData());
+    axpyUnchecked(diff, -1.0, subtrahend);
     return diff;
 } //OK
 
-IVector *IVector::mul(IVector const *multiplier, double scale, ILogger *logger) {
+IVector *IVector::mul(IVectorArena *arena, IVector const *multiplier, double scale, ILogger *logger) {
     if (multiplier == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
         return nullptr;
@@ -99,21 +138,194 @@ IVector *IVector::mul(IVector const *multiplier, double scale, ILogger *logger)
         return nullptr;
     }
 
-    double *coords = new(std::nothrow)double[multiplier->getDim()];
-    if (coords == nullptr) {
+    SparseVectorImpl const *sparse = dynamic_cast<SparseVectorImpl const *>(multiplier);
+    if (arena == nullptr && sparse != nullptr) {
+        SparseVectorImpl *prod = static_cast<SparseVectorImpl *>(sparse->clone());
+        if (prod == nullptr) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+            return nullptr;
+        }
+        prod->scale(scale);
+        return prod;
+    }
+
+    VectorImpl *prod = VectorImpl::create(multiplier->getDim(), arena, logger);
+    if (prod == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    multiplier->getCoords(0, multiplier->getDim(), prod->writeData());
+    kernelsFor(prod->getDim()).scale(prod->writeData(), scale, prod->getDim());
+    return prod;
+} //OK
+
+IVector *IVector::createVector(size_t dim, double *data, ILogger *logger) {
+    return createVector(nullptr, dim, data, logger);
+} //OK
+
+IVector *IVector::createVectorAdopt(size_t dim, double *data, bool trusted, ILogger *logger) {
+    if (dim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return nullptr;
+    }
+    if (data == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    for (size_t i = 0; !trusted && i < dim; ++i) {
+        if (std::isnan(data[i])) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+            return nullptr;
+        }
+    }
+
+    VectorImpl *vec = VectorImpl::adopt(dim, data);
+    if (vec == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+    }
+    return vec;
+} //OK
+
+IVector *IVector::createVector(size_t dim, double *data, IVector::Storage storage, ILogger *logger) {
+    if (storage == IVector::Storage::STORAGE_DOUBLE)
+        return createVector(dim, data, logger);
+    if (storage != IVector::Storage::STORAGE_FLOAT) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
         return nullptr;
     }
-    for (size_t i = 0; i < multiplier->getDim(); ++i) {
-        coords[i] = multiplier->getCoord(i) * scale;
+    if (dim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return nullptr;
+    }
+    if (data == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
     }
 
-    IVector *prod = new(std::nothrow)VectorImpl(multiplier->getDim(), coords);
-    if (prod == nullptr) {
+    FloatVectorImpl *vec = FloatVectorImpl::create(dim);
+    if (vec == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        delete[]coords;
+        return nullptr;
     }
-    return prod;
+    if (vec->setCoords(0, dim, data) != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+        delete vec;
+        return nullptr;
+    }
+    return vec;
+} //OK
+
+IVector *IVector::convert(IVector const *vector, IVector::Storage storage, ILogger *logger) {
+    if (vector == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (storage == IVector::Storage::STORAGE_DOUBLE)
+        return clone(nullptr, vector, logger);
+    if (storage != IVector::Storage::STORAGE_FLOAT) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return nullptr;
+    }
+
+    size_t dim = vector->getDim();
+    FloatVectorImpl *converted = FloatVectorImpl::create(dim);
+    if (converted == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    double scratch[DISTANCE_BLOCK];
+    double const *data = vector->getData();
+    for (size_t i = 0; i < dim; i += DISTANCE_BLOCK) {
+        size_t count = dim - i < DISTANCE_BLOCK ? dim - i : DISTANCE_BLOCK;
+        converted->setCoords(i, count, blockOf(vector, data, i, count, scratch));
+    }
+    return converted;
+} //OK
+
+IVector *IVector::createSparseVector(size_t dim, size_t nnz, size_t const *indices, double const *values, ILogger *logger) {
+    if (dim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return nullptr;
+    }
+    if (nnz > 0 && (indices == nullptr || values == nullptr)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (nnz > dim) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return nullptr;
+    }
+    for (size_t i = 0; i < nnz; ++i) {
+        if (indices[i] >= dim) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+            return nullptr;
+        }
+        if (i > 0 && indices[i] <= indices[i - 1]) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+            return nullptr;
+        }
+        if (std::isnan(values[i])) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+            return nullptr;
+        }
+    }
+
+    SparseVectorImpl *vec = SparseVectorImpl::create(dim, nnz);
+    if (vec == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    for (size_t i = 0; i < nnz; ++i)
+        vec->append(indices[i], values[i]);
+    return vec;
+} //OK
+
+IVector *IVector::createView(size_t dim, double *data, size_t stride, ILogger *logger) {
+    if (dim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return nullptr;
+    }
+    if (data == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (stride == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return nullptr;
+    }
+
+    IVector *view = new(std::nothrow)VectorViewImpl(dim, data, stride);
+    if (view == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+    }
+    return view;
+} //OK
+
+IVector *IVector::clone(IVectorArena *arena, IVector const *vector, ILogger *logger) {
+    if (vector == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+
+    VectorImpl *cloned = VectorImpl::create(vector->getDim(), arena, logger);
+    if (cloned == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    vector->getCoords(0, vector->getDim(), cloned->writeData());
+    return cloned;
+} //OK
+
+IVector *IVector::add(IVector const *addend1, IVector const *addend2, ILogger *logger) {
+    return add(nullptr, addend1, addend2, logger);
+} //OK
+
+IVector *IVector::sub(IVector const *minuend, IVector const *subtrahend, ILogger *logger) {
+    return sub(nullptr, minuend, subtrahend, logger);
+} //OK
+
+IVector *IVector::mul(IVector const *multiplier, double scale, ILogger *logger) {
+    return mul(nullptr, multiplier, scale, logger);
 } //OK
 
 double IVector::mul(IVector const *multiplier1, IVector const *multiplier2, ILogger *logger) {
@@ -126,14 +338,95 @@ double IVector::mul(IVector const *multiplier1, IVector const *multiplier2, ILog
         return std::nan("1");
     }
 
+    double const *data1 = multiplier1->getData();
+    double const *data2 = multiplier2->getData();
+    if (data1 != nullptr && data2 != nullptr)
+        return kernelsFor(multiplier1->getDim()).dot(data1, data2, multiplier1->getDim());
+    SparseVectorImpl const *sparse1 = dynamic_cast<SparseVectorImpl const *>(multiplier1);
+    SparseVectorImpl const *sparse2 = dynamic_cast<SparseVectorImpl const *>(multiplier2);
+    if (sparse1 != nullptr && sparse2 != nullptr)
+        return sparse1->dot(sparse2);
+    if (sparse1 != nullptr && data2 != nullptr)
+        return sparse1->dot(data2);
+    if (sparse2 != nullptr && data1 != nullptr)
+        return sparse2->dot(data1);
+
+    double scratch1[DISTANCE_BLOCK], scratch2[DISTANCE_BLOCK];
     double prod = 0;
-    for (size_t i = 0; i < multiplier1->getDim(); ++i) {
-        prod += multiplier1->getCoord(i) * multiplier2->getCoord(i);
+    size_t dim = multiplier1->getDim();
+    for (size_t i = 0; i < dim; i += DISTANCE_BLOCK) {
+        size_t count = dim - i < DISTANCE_BLOCK ? dim - i : DISTANCE_BLOCK;
+        prod += g_vectorKernels.dot(blockOf(multiplier1, data1, i, count, scratch1), blockOf(multiplier2, data2, i, count, scratch2), count);
     }
     return prod;
 } //OK
 
-ReturnCode IVector::equals(IVector const *v1, IVector const *v2, IVector::Norm norm, double tolerance, bool &result, ILogger *logger) {
+/* NORM_1 / NORM_INF distance or squared NORM_2 distance; stops once the partial value reaches bound */
+static double boundedDistance(IVector const *v1, IVector const *v2, IVector::Norm norm, double bound) {
+    double const *data1 = v1->getData();
+    double const *data2 = v2->getData();
+    if (data1 != nullptr && data2 != nullptr) {
+        switch (norm) {
+            case IVector::Norm::NORM_1:
+                return kernelsFor(v1->getDim()).distance1(data1, data2, v1->getDim(), bound);
+            case IVector::Norm::NORM_2:
+                return kernelsFor(v1->getDim()).distance2Squared(data1, data2, v1->getDim(), bound);
+            default:
+                return kernelsFor(v1->getDim()).distanceInf(data1, data2, v1->getDim(), bound);
+        }
+    }
+    SparseVectorImpl const *sparse1 = dynamic_cast<SparseVectorImpl const *>(v1);
+    SparseVectorImpl const *sparse2 = dynamic_cast<SparseVectorImpl const *>(v2);
+    if (sparse1 != nullptr && sparse2 != nullptr)
+        return sparse1->distance(sparse2, norm, bound);
+
+    double scratch1[DISTANCE_BLOCK], scratch2[DISTANCE_BLOCK];
+    double dist = 0;
+    size_t dim = v1->getDim();
+    for (size_t i = 0; i < dim && dist < bound; i += DISTANCE_BLOCK) {
+        size_t count = dim - i < DISTANCE_BLOCK ? dim - i : DISTANCE_BLOCK;
+        double const *block1 = blockOf(v1, data1, i, count, scratch1);
+        double const *block2 = blockOf(v2, data2, i, count, scratch2);
+        switch (norm) {
+            case IVector::Norm::NORM_1:
+                dist += g_vectorKernels.distance1(block1, block2, count, HUGE_VAL);
+                break;
+            case IVector::Norm::NORM_2:
+                dist += g_vectorKernels.distance2Squared(block1, block2, count, HUGE_VAL);
+                break;
+            default: {
+                double blockDist = g_vectorKernels.distanceInf(block1, block2, count, HUGE_VAL);
+                dist = (blockDist > dist || std::isnan(blockDist)) ? blockDist : dist;
+                break;
+            }
+        }
+    }
+    return dist;
+} //OK
+
+static bool isValidNorm(IVector::Norm norm) {
+    return norm == IVector::Norm::NORM_1 || norm == IVector::Norm::NORM_2 || norm == IVector::Norm::NORM_INF;
+} //OK
+
+double IVector::distance(IVector const *v1, IVector const *v2, IVector::Norm norm, ILogger *logger) {
+    if (v1 == nullptr || v2 == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return std::nan("1");
+    }
+    if (v1->getDim() != v2->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return std::nan("1");
+    }
+    if (!isValidNorm(norm)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return std::nan("1");
+    }
+
+    double dist = boundedDistance(v1, v2, norm, HUGE_VAL);
+    return norm == IVector::Norm::NORM_2 ? std::sqrt(dist) : dist;
+} //OK
+
+ReturnCode IVector::withinTolerance(IVector const *v1, IVector const *v2, IVector::Norm norm, double tolerance, bool &result, ILogger *logger) {
     result = false;
     if (v1 == nullptr || v2 == nullptr) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
@@ -147,25 +440,307 @@ ReturnCode IVector::equals(IVector const *v1, IVector const *v2, IVector::Norm n
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
         return ReturnCode::RC_NAN;
     }
-    if (tolerance < 0) {
+    if (tolerance < 0 || !isValidNorm(norm)) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
         return ReturnCode::RC_INVALID_PARAMS;
     }
 
-    IVector *diff = sub(v1, v2, logger);
-    if (diff == nullptr) {
-        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
-        return ReturnCode::RC_INVALID_PARAMS;
+    double bound = norm == IVector::Norm::NORM_2 ? tolerance * tolerance : tolerance;
+    double dist = boundedDistance(v1, v2, norm, bound);
+    if (std::isnan(dist)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+
+    result = dist < bound || (dist == 0 && tolerance > 0);
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode IVector::equals(IVector const *v1, IVector const *v2, IVector::Norm norm, double tolerance, bool &result, ILogger *logger) {
+    return withinTolerance(v1, v2, norm, tolerance, result, logger);
+} //OK
+
+ReturnCode IVector::addInPlace(IVector *dst, IVector const *addend, ILogger *logger) {
+    if (dst == nullptr || addend == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
     }
+    if (dst->getDim() != addend->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+
+    ReturnCode rc = axpyUnchecked(dst, 1.0, addend);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
+
+ReturnCode IVector::subInPlace(IVector *dst, IVector const *subtrahend, ILogger *logger) {
+    if (dst == nullptr || subtrahend == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (dst->getDim() != subtrahend->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+
+    ReturnCode rc = axpyUnchecked(dst, -1.0, subtrahend);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
 
-    double diff_norm = diff->norm(norm);
-    if (std::isnan(diff_norm)) {
+ReturnCode IVector::scaleInPlace(IVector *dst, double scale, ILogger *logger) {
+    if (dst == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (std::isnan(scale)) {
         VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
         return ReturnCode::RC_NAN;
     }
 
-    result = diff_norm < tolerance;
-    delete diff;
+    double *data = writableData(dst);
+    if (data != nullptr) {
+        kernelsFor(dst->getDim()).scale(data, scale, dst->getDim());
+        return ReturnCode::RC_SUCCESS;
+    }
+    SparseVectorImpl *sparse = dynamic_cast<SparseVectorImpl *>(dst);
+    if (sparse != nullptr) {
+        sparse->scale(scale);
+        return ReturnCode::RC_SUCCESS;
+    }
+
+    ReturnCode rc = ReturnCode::RC_SUCCESS;
+    for (size_t i = 0; rc == ReturnCode::RC_SUCCESS && i < dst->getDim(); ++i)
+        rc = dst->setCoord(i, dst->getCoord(i) * scale);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
 
+ReturnCode IVector::axpy(IVector *y, double a, IVector const *x, ILogger *logger) {
+    if (y == nullptr || x == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (y->getDim() != x->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+    if (std::isnan(a)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+
+    ReturnCode rc = axpyUnchecked(y, a, x);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
+
+ReturnCode IVector::lincomb(IVector *dst, double a, IVector const *x, double b, IVector const *y, ILogger *logger) {
+    if (dst == nullptr || x == nullptr || y == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (dst->getDim() != x->getDim() || dst->getDim() != y->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+    if (std::isnan(a) || std::isnan(b)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+
+    double *dataDst = writableData(dst);
+    double const *dataX = x->getData();
+    double const *dataY = y->getData();
+    if (dataDst != nullptr && dataX != nullptr && dataY != nullptr) {
+        kernelsFor(dst->getDim()).axpby(dataDst, a, dataX, b, dataY, dst->getDim());
+        return ReturnCode::RC_SUCCESS;
+    }
+
+    ReturnCode rc = ReturnCode::RC_SUCCESS;
+    for (size_t i = 0; rc == ReturnCode::RC_SUCCESS && i < dst->getDim(); ++i)
+        rc = dst->setCoord(i, a * x->getCoord(i) + b * y->getCoord(i));
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
+
+ReturnCode IVector::hash(IVector const *vector, double cellSize, uint64_t &key, ILogger *logger) {
+    if (vector == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    ReturnCode rc = checkGrid(cellSize, 0);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+        return rc;
+    }
+
+    double scale = 1 / cellSize;
+    double const *data = vector->getData();
+    double scratch[DISTANCE_BLOCK];
+    uint64_t sum = 0;
+    size_t dim = vector->getDim();
+    for (size_t i = 0; i < dim; i += DISTANCE_BLOCK) {
+        size_t count = dim - i < DISTANCE_BLOCK ? dim - i : DISTANCE_BLOCK;
+        sum += hashCells(blockOf(vector, data, i, count, scratch), i, count, scale);
+    }
+    key = finishKey(sum);
     return ReturnCode::RC_SUCCESS;
 } //OK
+
+ReturnCode IVector::neighbourKeys(IVector const *vector, double cellSize, double tolerance, uint64_t *keys, size_t capacity, size_t &count, ILogger *logger) {
+    count = 0;
+    if (vector == nullptr || keys == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    ReturnCode rc = checkGrid(cellSize, tolerance);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+        return rc;
+    }
+
+    double scale = 1 / cellSize;
+    size_t limit = deltaLimit(capacity);
+    double const *data = vector->getData();
+    double scratch[DISTANCE_BLOCK];
+    uint64_t deltas[64];
+    uint64_t sum = 0;
+    size_t found = 0;
+    size_t dim = vector->getDim();
+    for (size_t i = 0; i < dim && found <= limit; i += DISTANCE_BLOCK) {
+        size_t blockCount = dim - i < DISTANCE_BLOCK ? dim - i : DISTANCE_BLOCK;
+        double const *block = blockOf(vector, data, i, blockCount, scratch);
+        sum += hashCells(block, i, blockCount, scale);
+        found = cellDeltas(block, i, blockCount, scale, tolerance * scale, deltas, found, limit);
+    }
+    if (capacity == 0 || found > limit) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    expandKeys(sum, deltas, found, keys);
+    count = static_cast<size_t>(1) << found;
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+/* coordinates per block of the multi-vector lincomb: the block accumulator stays in L1 while every input streams through once */
+static const size_t LINCOMB_BLOCK = 512;
+
+static ReturnCode checkLincomb(double const *coeffs, IVector const *const *vectors, size_t n, size_t dim) {
+    if (coeffs == nullptr || vectors == nullptr)
+        return ReturnCode::RC_NULL_PTR;
+    for (size_t i = 0; i < n; ++i) {
+        if (vectors[i] == nullptr)
+            return ReturnCode::RC_NULL_PTR;
+        if (vectors[i]->getDim() != dim)
+            return ReturnCode::RC_WRONG_DIM;
+        if (std::isnan(coeffs[i]))
+            return ReturnCode::RC_NAN;
+    }
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+/* dst += sum of coeffs[i] * vectors[i] block by block; dst may be one of the vectors, as it is only written once
+ * a block of every input has been read. Sparse inputs are added at the end when dst is contiguous */
+static ReturnCode lincombUnchecked(IVector *dst, double const *coeffs, IVector const *const *vectors, size_t n) {
+    size_t dim = dst->getDim();
+    double *dataDst = writableData(dst);
+    double acc[LINCOMB_BLOCK], scratch[LINCOMB_BLOCK];
+    ReturnCode rc = ReturnCode::RC_SUCCESS;
+    for (size_t begin = 0; rc == ReturnCode::RC_SUCCESS && begin < dim; begin += LINCOMB_BLOCK) {
+        size_t count = dim - begin < LINCOMB_BLOCK ? dim - begin : LINCOMB_BLOCK;
+        std::memset(acc, 0, count * sizeof(double));
+        for (size_t i = 0; i < n; ++i) {
+            double const *data = vectors[i]->getData();
+            if (data == nullptr && dataDst != nullptr && dynamic_cast<SparseVectorImpl const *>(vectors[i]) != nullptr)
+                continue;
+            g_vectorKernels.axpy(acc, coeffs[i], blockOf(vectors[i], data, begin, count, scratch), count);
+        }
+        if (dataDst != nullptr) {
+            g_vectorKernels.axpy(dataDst + begin, 1.0, acc, count);
+        } else {
+            dst->getCoords(begin, count, scratch);
+            g_vectorKernels.axpy(scratch, 1.0, acc, count);
+            rc = dst->setCoords(begin, count, scratch);
+        }
+    }
+
+    for (size_t i = 0; rc == ReturnCode::RC_SUCCESS && dataDst != nullptr && i < n; ++i) {
+        SparseVectorImpl const *sparse = dynamic_cast<SparseVectorImpl const *>(vectors[i]);
+        if (sparse != nullptr)
+            sparse->axpyInto(dataDst, coeffs[i]);
+    }
+    return rc;
+} //OK
+
+IVector *IVector::lincomb(double const *coeffs, IVector const *const *vectors, size_t n, ILogger *logger) {
+    if (n == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return nullptr;
+    }
+    if (vectors == nullptr || vectors[0] == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    ReturnCode rc = checkLincomb(coeffs, vectors, n, vectors[0]->getDim());
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+        return nullptr;
+    }
+
+    VectorImpl *sum = VectorImpl::create(vectors[0]->getDim(), nullptr, logger);
+    if (sum == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    std::memset(sum->writeData(), 0, sum->getDim() * sizeof(double));
+    lincombUnchecked(sum, coeffs, vectors, n);
+    return sum;
+} //OK
+
+ReturnCode IVector::lincombAccumulate(IVector *dst, double const *coeffs, IVector const *const *vectors, size_t n, ILogger *logger) {
+    if (dst == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    ReturnCode rc = checkLincomb(coeffs, vectors, n, dst->getDim());
+    if (rc == ReturnCode::RC_SUCCESS)
+        rc = lincombUnchecked(dst, coeffs, vectors, n);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
+
+ReturnCode IVector::setExecution(IVector::Execution execution, size_t minDim, ILogger *logger) {
+    if (execution != IVector::Execution::EXEC_SEQUENTIAL && execution != IVector::Execution::EXEC_PARALLEL) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return ReturnCode::RC_INVALID_PARAMS;
+    }
+    if (minDim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return ReturnCode::RC_ZERO_DIM;
+    }
+    setParallelPolicy(execution == IVector::Execution::EXEC_PARALLEL, minDim);
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+IVector::Execution IVector::getExecution() {
+    return isParallelPolicy() ? IVector::Execution::EXEC_PARALLEL : IVector::Execution::EXEC_SEQUENTIAL;
+} //OK
+
+size_t IVector::getParallelMinDim() {
+    return getParallelMinLen();
+} //OK
@@ -0,0 +1,17 @@
+#include "IVectorArena.h"
+#include "VectorArenaImpl.cpp"
+
+IVectorArena::~IVectorArena() {}
+
+IVectorArena *IVectorArena::createArena(size_t blockSize, ILogger *logger) {
+    if (blockSize == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return nullptr;
+    }
+
+    IVectorArena *arena = new(std::nothrow) VectorArenaImpl(blockSize);
+    if (arena == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+    }
+    return arena;
+} //OK
@@ -0,0 +1,428 @@
+#include "IVectorBatch.h"
+#include "VectorBatchImpl.cpp"
+#include "VectorKernels.h"
+#include "ThreadPool.h"
+#include "VectorHash.h"
+#include <limits>
+
+IVectorBatch::~IVectorBatch() {}
+
+static double *allocateBlock(size_t size, size_t dim, ILogger *logger) {
+    if (size == 0 || dim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return nullptr;
+    }
+    if (dim > std::numeric_limits<size_t>::max() / sizeof(double) / size) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+
+    double *block = new(std::nothrow)double[size * dim];
+    if (block == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+    }
+    return block;
+} //OK
+
+static IVectorBatch *wrapBlock(size_t size, size_t dim, double *block, ILogger *logger) {
+    IVectorBatch *batch = new(std::nothrow)VectorBatchImpl(size, dim, block);
+    if (batch == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        delete[]block;
+    }
+    return batch;
+} //OK
+
+IVectorBatch *IVectorBatch::createBatch(size_t size, size_t dim, double const *data, ILogger *logger) {
+    if (data == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+
+    double *block = allocateBlock(size, dim, logger);
+    if (block == nullptr)
+        return nullptr;
+
+    size_t len = size * dim;
+    for (size_t i = 0; i < len; ++i) {
+        if (std::isnan(data[i])) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+            delete[]block;
+            return nullptr;
+        }
+        block[i] = data[i];
+    }
+    return wrapBlock(size, dim, block, logger);
+} //OK
+
+IVectorBatch *IVectorBatch::createBatch(IVector const *const *vectors, size_t size, ILogger *logger) {
+    if (vectors == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    for (size_t j = 0; j < size; ++j) {
+        if (vectors[j] == nullptr) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+            return nullptr;
+        }
+        if (vectors[j]->getDim() != vectors[0]->getDim()) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+            return nullptr;
+        }
+    }
+
+    size_t dim = size == 0 ? 0 : vectors[0]->getDim();
+    double *block = allocateBlock(size, dim, logger);
+    if (block == nullptr)
+        return nullptr;
+
+    double *row = block;
+    for (size_t j = 0; j < size; ++j, row += dim)
+        vectors[j]->getCoords(0, dim, row);
+    return wrapBlock(size, dim, block, logger);
+} //OK
+
+IVectorBatch *IVectorBatch::add(IVectorBatch const *addend1, IVectorBatch const *addend2, ILogger *logger) {
+    if (addend1 == nullptr || addend2 == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (addend1->getDim() != addend2->getDim() || addend1->getSize() != addend2->getSize()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return nullptr;
+    }
+
+    double *block = allocateBlock(addend1->getSize(), addend1->getDim(), logger);
+    if (block == nullptr)
+        return nullptr;
+
+    double const *lhs = addend1->getData();
+    double const *rhs = addend2->getData();
+    size_t len = addend1->getSize() * addend1->getDim();
+    for (size_t i = 0; i < len; ++i)
+        block[i] = lhs[i] + rhs[i];
+
+    return wrapBlock(addend1->getSize(), addend1->getDim(), block, logger);
+} //OK
+
+IVectorBatch *IVectorBatch::add(IVectorBatch const *addend1, IVector const *addend2, ILogger *logger) {
+    if (addend1 == nullptr || addend2 == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (addend1->getDim() != addend2->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return nullptr;
+    }
+
+    size_t dim = addend1->getDim();
+    double *block = allocateBlock(addend1->getSize(), dim, logger);
+    if (block == nullptr)
+        return nullptr;
+
+    addend2->getCoords(0, dim, block);
+
+    double const *lhs = addend1->getData();
+    double *row = block + dim;
+    for (size_t j = 1; j < addend1->getSize(); ++j, row += dim) {
+        for (size_t i = 0; i < dim; ++i)
+            row[i] = block[i];
+    }
+    size_t len = addend1->getSize() * dim;
+    for (size_t i = 0; i < len; ++i)
+        block[i] += lhs[i];
+
+    return wrapBlock(addend1->getSize(), dim, block, logger);
+} //OK
+
+IVectorBatch *IVectorBatch::sub(IVectorBatch const *minuend, IVectorBatch const *subtrahend, ILogger *logger) {
+    if (minuend == nullptr || subtrahend == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (minuend->getDim() != subtrahend->getDim() || minuend->getSize() != subtrahend->getSize()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return nullptr;
+    }
+
+    double *block = allocateBlock(minuend->getSize(), minuend->getDim(), logger);
+    if (block == nullptr)
+        return nullptr;
+
+    double const *lhs = minuend->getData();
+    double const *rhs = subtrahend->getData();
+    size_t len = minuend->getSize() * minuend->getDim();
+    for (size_t i = 0; i < len; ++i)
+        block[i] = lhs[i] - rhs[i];
+
+    return wrapBlock(minuend->getSize(), minuend->getDim(), block, logger);
+} //OK
+
+IVectorBatch *IVectorBatch::sub(IVectorBatch const *minuend, IVector const *subtrahend, ILogger *logger) {
+    if (minuend == nullptr || subtrahend == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (minuend->getDim() != subtrahend->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return nullptr;
+    }
+
+    size_t dim = minuend->getDim();
+    double *block = allocateBlock(minuend->getSize(), dim, logger);
+    if (block == nullptr)
+        return nullptr;
+
+    subtrahend->getCoords(0, dim, block);
+    g_vectorKernels.scale(block, -1.0, dim);
+
+    double const *lhs = minuend->getData();
+    double *row = block + dim;
+    for (size_t j = 1; j < minuend->getSize(); ++j, row += dim) {
+        for (size_t i = 0; i < dim; ++i)
+            row[i] = block[i];
+    }
+    size_t len = minuend->getSize() * dim;
+    for (size_t i = 0; i < len; ++i)
+        block[i] += lhs[i];
+
+    return wrapBlock(minuend->getSize(), dim, block, logger);
+} //OK
+
+IVectorBatch *IVectorBatch::mul(IVectorBatch const *multiplier, double scale, ILogger *logger) {
+    if (multiplier == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return nullptr;
+    }
+    if (std::isnan(scale)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return nullptr;
+    }
+
+    double *block = allocateBlock(multiplier->getSize(), multiplier->getDim(), logger);
+    if (block == nullptr)
+        return nullptr;
+
+    double const *src = multiplier->getData();
+    size_t len = multiplier->getSize() * multiplier->getDim();
+    for (size_t i = 0; i < len; ++i)
+        block[i] = src[i] * scale;
+
+    return wrapBlock(multiplier->getSize(), multiplier->getDim(), block, logger);
+} //OK
+
+ReturnCode IVectorBatch::mul(IVectorBatch const *multiplier1, IVectorBatch const *multiplier2, double *products, ILogger *logger) {
+    if (multiplier1 == nullptr || multiplier2 == nullptr || products == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (multiplier1->getDim() != multiplier2->getDim() || multiplier1->getSize() != multiplier2->getSize()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+
+    size_t dim = multiplier1->getDim();
+    double const *lhs = multiplier1->getData();
+    double const *rhs = multiplier2->getData();
+    for (size_t j = 0; j < multiplier1->getSize(); ++j, lhs += dim, rhs += dim)
+        products[j] = g_vectorKernels.dot(lhs, rhs, dim);
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode IVectorBatch::norm(IVectorBatch const *batch, IVector::Norm norm, double *norms, ILogger *logger) {
+    if (batch == nullptr || norms == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+
+    size_t dim = batch->getDim();
+    double const *row = batch->getData();
+    switch (norm) {
+        case IVector::Norm::NORM_1:
+            for (size_t j = 0; j < batch->getSize(); ++j, row += dim)
+                norms[j] = g_vectorKernels.norm1(row, dim);
+            break;
+        case IVector::Norm::NORM_2:
+            for (size_t j = 0; j < batch->getSize(); ++j, row += dim)
+                norms[j] = std::sqrt(g_vectorKernels.sumSquares(row, dim));
+            break;
+        case IVector::Norm::NORM_INF:
+            for (size_t j = 0; j < batch->getSize(); ++j, row += dim)
+                norms[j] = g_vectorKernels.normInf(row, dim);
+            break;
+        default:
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+            return ReturnCode::RC_INVALID_PARAMS;
+    }
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode IVectorBatch::hash(IVectorBatch const *batch, double cellSize, uint64_t *keys, ILogger *logger) {
+    if (batch == nullptr || keys == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    ReturnCode rc = checkGrid(cellSize, 0);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+        return rc;
+    }
+
+    double scale = 1 / cellSize;
+    size_t dim = batch->getDim();
+    double const *row = batch->getData();
+    for (size_t j = 0; j < batch->getSize(); ++j, row += dim)
+        keys[j] = finishKey(hashCells(row, 0, dim, scale));
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode IVectorBatch::neighbourKeys(IVectorBatch const *batch, double cellSize, double tolerance, uint64_t *keys, size_t capacity, size_t *counts, ILogger *logger) {
+    if (batch == nullptr || keys == nullptr || counts == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    ReturnCode rc = checkGrid(cellSize, tolerance);
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+        return rc;
+    }
+
+    double scale = 1 / cellSize;
+    size_t limit = deltaLimit(capacity);
+    size_t dim = batch->getDim();
+    double const *row = batch->getData();
+    uint64_t deltas[64];
+    for (size_t j = 0; j < batch->getSize(); ++j, row += dim) {
+        size_t found = cellDeltas(row, 0, dim, scale, tolerance * scale, deltas, 0, limit);
+        if (capacity == 0 || found > limit) {
+            counts[j] = 0;
+            rc = ReturnCode::RC_OUT_OF_BOUNDS;
+            continue;
+        }
+        expandKeys(hashCells(row, 0, dim, scale), deltas, found, keys + j * capacity);
+        counts[j] = static_cast<size_t>(1) << found;
+    }
+    if (rc != ReturnCode::RC_SUCCESS) {
+        VECLOG(logger, MSG_DEFAULT, rc);
+    }
+    return rc;
+} //OK
+
+/* rows of either batch per tile and coordinates per inner-product pass; a 64 x 256 tile of doubles is 128 KiB */
+static const size_t PAIRWISE_TILE = 64;
+static const size_t PAIRWISE_DEPTH = 256;
+/* coordinate operations below which pairwise distances stay on the calling thread */
+static const size_t PAIRWISE_PARALLEL_MIN = 1 << 20;
+
+/* matrix[i][j] += lhs row i . rhs row j over depth coordinates from kBegin, for i in [iBegin, iEnd), j in [jBegin, jEnd):
+ * DOT_BLOCK x DOT_BLOCK blocks go through the register-blocked dotBlock kernel, the ragged edges through dot */
+static void pairwiseDots(double const *lhs, double const *rhs, size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+                         size_t kBegin, size_t depth, size_t size2, size_t dim, double *matrix) {
+    double block[DOT_BLOCK * DOT_BLOCK];
+    for (size_t i = iBegin; i < iEnd; i += DOT_BLOCK) {
+        size_t rows = iEnd - i > DOT_BLOCK ? DOT_BLOCK : iEnd - i;
+        for (size_t j = jBegin; j < jEnd; j += DOT_BLOCK) {
+            size_t cols = jEnd - j > DOT_BLOCK ? DOT_BLOCK : jEnd - j;
+            if (rows == DOT_BLOCK && cols == DOT_BLOCK) {
+                g_vectorKernels.dotBlock(lhs + i * dim + kBegin, rhs + j * dim + kBegin, dim, depth, block);
+                for (size_t r = 0; r < DOT_BLOCK; ++r) {
+                    for (size_t c = 0; c < DOT_BLOCK; ++c)
+                        matrix[(i + r) * size2 + j + c] += block[r * DOT_BLOCK + c];
+                }
+                continue;
+            }
+            for (size_t r = 0; r < rows; ++r) {
+                for (size_t c = 0; c < cols; ++c)
+                    matrix[(i + r) * size2 + j + c] += g_vectorKernels.dot(lhs + (i + r) * dim + kBegin, rhs + (j + c) * dim + kBegin, depth);
+            }
+        }
+    }
+} //OK
+
+/* NORM_2 rows [begin, end) of the distance matrix from |a|^2 + |b|^2 - 2ab, as a GEMM blocked into PAIRWISE_TILE
+ * rows of each batch and PAIRWISE_DEPTH coordinates. The subtraction cancels when a and b are nearly equal: its
+ * absolute error is about eps * (|a|^2 + |b|^2), so near-duplicate rows may come out as 0 (negative results are
+ * clamped) or off by up to sqrt(eps) * |a|. */
+static void pairwiseNorm2(double const *lhs, double const *rhs, double const *squares1, double const *squares2,
+                          size_t begin, size_t end, size_t size2, size_t dim, double *matrix) {
+    for (size_t iBegin = begin; iBegin < end; iBegin += PAIRWISE_TILE) {
+        size_t iEnd = end - iBegin > PAIRWISE_TILE ? iBegin + PAIRWISE_TILE : end;
+        for (size_t jBegin = 0; jBegin < size2; jBegin += PAIRWISE_TILE) {
+            size_t jEnd = size2 - jBegin > PAIRWISE_TILE ? jBegin + PAIRWISE_TILE : size2;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                for (size_t j = jBegin; j < jEnd; ++j)
+                    matrix[i * size2 + j] = 0;
+            }
+            for (size_t kBegin = 0; kBegin < dim; kBegin += PAIRWISE_DEPTH) {
+                size_t depth = dim - kBegin > PAIRWISE_DEPTH ? PAIRWISE_DEPTH : dim - kBegin;
+                pairwiseDots(lhs, rhs, iBegin, iEnd, jBegin, jEnd, kBegin, depth, size2, dim, matrix);
+            }
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    double squared = squares1[i] + squares2[j] - 2 * matrix[i * size2 + j];
+                    matrix[i * size2 + j] = squared > 0 ? std::sqrt(squared) : 0;
+                }
+            }
+        }
+    }
+} //OK
+
+/* NORM_1 / NORM_INF rows [begin, end) of the distance matrix, blocked over columns */
+static void pairwiseTiled(double const *lhs, double const *rhs, IVector::Norm norm, size_t begin, size_t end, size_t size2, size_t dim, double *matrix) {
+    for (size_t jBegin = 0; jBegin < size2; jBegin += PAIRWISE_TILE) {
+        size_t jEnd = size2 - jBegin > PAIRWISE_TILE ? jBegin + PAIRWISE_TILE : size2;
+        for (size_t i = begin; i < end; ++i) {
+            double const *row = lhs + i * dim;
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                matrix[i * size2 + j] = norm == IVector::Norm::NORM_1 ? g_vectorKernels.distance1(row, rhs + j * dim, dim, HUGE_VAL)
+                                                                      : g_vectorKernels.distanceInf(row, rhs + j * dim, dim, HUGE_VAL);
+            }
+        }
+    }
+} //OK
+
+ReturnCode IVectorBatch::distances(IVectorBatch const *batch1, IVectorBatch const *batch2, IVector::Norm norm, double *matrix, ILogger *logger) {
+    if (batch1 == nullptr || batch2 == nullptr || matrix == nullptr) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (batch1->getDim() != batch2->getDim()) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+    if (norm != IVector::Norm::NORM_1 && norm != IVector::Norm::NORM_2 && norm != IVector::Norm::NORM_INF) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+        return ReturnCode::RC_INVALID_PARAMS;
+    }
+
+    size_t size1 = batch1->getSize(), size2 = batch2->getSize(), dim = batch1->getDim();
+    double const *lhs = batch1->getData();
+    double const *rhs = batch2->getData();
+    double *squares = nullptr;
+    if (norm == IVector::Norm::NORM_2) {
+        squares = new(std::nothrow)double[size1 + size2];
+        if (squares == nullptr) {
+            VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+            return ReturnCode::RC_NO_MEM;
+        }
+        for (size_t i = 0; i < size1; ++i)
+            squares[i] = g_vectorKernels.sumSquares(lhs + i * dim, dim);
+        for (size_t j = 0; j < size2; ++j)
+            squares[size1 + j] = g_vectorKernels.sumSquares(rhs + j * dim, dim);
+    }
+
+    size_t tiles = (size1 + PAIRWISE_TILE - 1) / PAIRWISE_TILE;
+    double work = static_cast<double>(size1) * size2 * dim;
+    size_t minChunk = work < PAIRWISE_PARALLEL_MIN ? tiles : 1;
+    ThreadPool::parallelFor(tiles, minChunk, [&](size_t tileBegin, size_t tileEnd) {
+        size_t begin = tileBegin * PAIRWISE_TILE;
+        size_t end = size1 - begin > (tileEnd - tileBegin) * PAIRWISE_TILE ? tileEnd * PAIRWISE_TILE : size1;
+        if (norm == IVector::Norm::NORM_2)
+            pairwiseNorm2(lhs, rhs, squares, squares + size1, begin, end, size2, dim, matrix);
+        else
+            pairwiseTiled(lhs, rhs, norm, begin, end, size2, dim, matrix);
+    });
+
+    delete[]squares;
+    return ReturnCode::RC_SUCCESS;
+} //OK
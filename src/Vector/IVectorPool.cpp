@@ -0,0 +1,40 @@
+#include "IVectorPool.h"
+#include "VectorPool.h"
+
+#define MSG_DEFAULT __FUNCTION__
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
+}
+
+ReturnCode IVectorPool::enable(size_t dim, ILogger *logger) {
+    if (dim == 0) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_ZERO_DIM);
+        return ReturnCode::RC_ZERO_DIM;
+    }
+    if (!VectorPool::instance().enable(dim)) {
+        VECLOG(logger, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+bool IVectorPool::isEnabled(size_t dim) {
+    return VectorPool::instance().isEnabled(dim);
+} //OK
+
+IVectorPool::Stats IVectorPool::getStats() {
+    VectorPool const &pool = VectorPool::instance();
+    Stats stats;
+    stats.hits = pool.getHits();
+    stats.misses = pool.getMisses();
+    stats.hitRate = stats.hits + stats.misses > 0 ? static_cast<double>(stats.hits) / (stats.hits + stats.misses) : 0;
+    stats.live = pool.getLive();
+    stats.bytesHeld = pool.getBytesHeld();
+    return stats;
+} //OK
+
+void IVectorPool::trim() {
+    VectorPool::instance().trim();
+} //OK
@@ -0,0 +1,152 @@
+#include "ParallelKernels.h"
+#include "ThreadPool.h"
+#include "IVector.h"
+#include <atomic>
+#include <cmath>
+
+/* coordinates per chunk; buffers long enough to need more than PARALLEL_MAX_CHUNKS chunks get longer ones */
+static const size_t PARALLEL_CHUNK = 1 << 15;
+static const size_t PARALLEL_MAX_CHUNKS = 256;
+
+static std::atomic<bool> s_parallel(false);
+static std::atomic<size_t> s_minLen(IVector::PARALLEL_MIN_DIM);
+
+namespace {
+    size_t chunkLength(size_t len) {
+        size_t chunk = (len + PARALLEL_MAX_CHUNKS - 1) / PARALLEL_MAX_CHUNKS;
+        return chunk > PARALLEL_CHUNK ? chunk : PARALLEL_CHUNK;
+    }
+
+    /* runs body(k, begin, end) on every chunk k of [0, len) over the pool and returns the number of chunks */
+    template <class Body>
+    size_t forEachChunk(size_t len, Body const &body) {
+        size_t chunk = chunkLength(len);
+        size_t chunks = (len + chunk - 1) / chunk;
+        ThreadPool::parallelFor(chunks, 1, [&](size_t first, size_t last) {
+            for (size_t k = first; k < last; ++k) {
+                size_t begin = k * chunk;
+                body(k, begin, len - begin > chunk ? begin + chunk : len);
+            }
+        });
+        return chunks;
+    }
+
+    /* result of body(begin, end) for every chunk, in chunk order */
+    template <class Body>
+    size_t reduceChunks(size_t len, double *partials, Body const &body) {
+        return forEachChunk(len, [&](size_t k, size_t begin, size_t end) {
+            partials[k] = body(begin, end);
+        });
+    }
+
+    template <class Body>
+    double sumChunks(size_t len, Body const &body) {
+        double partials[PARALLEL_MAX_CHUNKS];
+        size_t chunks = reduceChunks(len, partials, body);
+        double sum = 0;
+        for (size_t k = 0; k < chunks; ++k)
+            sum += partials[k];
+        return sum;
+    }
+
+    /* NaN wins, as in the sequential kernels */
+    template <class Body>
+    double maxChunks(size_t len, Body const &body) {
+        double partials[PARALLEL_MAX_CHUNKS];
+        size_t chunks = reduceChunks(len, partials, body);
+        double max = 0;
+        for (size_t k = 0; k < chunks; ++k)
+            max = (partials[k] > max || std::isnan(partials[k])) ? partials[k] : max;
+        return max;
+    }
+
+    double norm1Parallel(double const *data, size_t len) {
+        return sumChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.norm1(data + begin, end - begin);
+        });
+    }
+
+    double sumSquaresParallel(double const *data, size_t len) {
+        return sumChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.sumSquares(data + begin, end - begin);
+        });
+    }
+
+    double normInfParallel(double const *data, size_t len) {
+        return maxChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.normInf(data + begin, end - begin);
+        });
+    }
+
+    double dotParallel(double const *data1, double const *data2, size_t len) {
+        return sumChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.dot(data1 + begin, data2 + begin, end - begin);
+        });
+    }
+
+    /* a chunk reaching bound makes the whole distance reach it, so each chunk keeps the early exit */
+    double distance1Parallel(double const *data1, double const *data2, size_t len, double bound) {
+        return sumChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.distance1(data1 + begin, data2 + begin, end - begin, bound);
+        });
+    }
+
+    double distance2SquaredParallel(double const *data1, double const *data2, size_t len, double bound) {
+        return sumChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.distance2Squared(data1 + begin, data2 + begin, end - begin, bound);
+        });
+    }
+
+    double distanceInfParallel(double const *data1, double const *data2, size_t len, double bound) {
+        return maxChunks(len, [=](size_t begin, size_t end) {
+            return g_vectorKernels.distanceInf(data1 + begin, data2 + begin, end - begin, bound);
+        });
+    }
+
+    void axpyParallel(double *y, double a, double const *x, size_t len) {
+        forEachChunk(len, [=](size_t, size_t begin, size_t end) {
+            g_vectorKernels.axpy(y + begin, a, x + begin, end - begin);
+        });
+    }
+
+    void axpbyParallel(double *dst, double a, double const *x, double b, double const *y, size_t len) {
+        forEachChunk(len, [=](size_t, size_t begin, size_t end) {
+            g_vectorKernels.axpby(dst + begin, a, x + begin, b, y + begin, end - begin);
+        });
+    }
+
+    void scaleParallel(double *data, double a, size_t len) {
+        forEachChunk(len, [=](size_t, size_t begin, size_t end) {
+            g_vectorKernels.scale(data + begin, a, end - begin);
+        });
+    }
+
+    /* a block is small work; callers spread whole blocks over the pool instead */
+    void dotBlockSerial(double const *lhs, double const *rhs, size_t stride, size_t len, double *out) {
+        g_vectorKernels.dotBlock(lhs, rhs, stride, len, out);
+    }
+
+    VectorKernels const g_parallelKernels = {
+            norm1Parallel, sumSquaresParallel, normInfParallel, dotParallel,
+            distance1Parallel, distance2SquaredParallel, distanceInfParallel,
+            axpyParallel, axpbyParallel, scaleParallel, dotBlockSerial, "parallel"};
+}
+
+VectorKernels const &kernelsFor(size_t len) {
+    if (s_parallel.load(std::memory_order_relaxed) && len >= s_minLen.load(std::memory_order_relaxed))
+        return g_parallelKernels;
+    return g_vectorKernels;
+} //OK
+
+void setParallelPolicy(bool parallel, size_t minLen) {
+    s_minLen.store(minLen, std::memory_order_relaxed);
+    s_parallel.store(parallel, std::memory_order_relaxed);
+} //OK
+
+bool isParallelPolicy() {
+    return s_parallel.load(std::memory_order_relaxed);
+} //OK
+
+size_t getParallelMinLen() {
+    return s_minLen.load(std::memory_order_relaxed);
+} //OK
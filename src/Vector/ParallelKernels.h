@@ -0,0 +1,14 @@
+#ifndef PARALLELKERNELS_H
+#define PARALLELKERNELS_H
+
+#include "VectorKernels.h"
+
+/* g_vectorKernels, or its multithreaded counterpart when the execution policy is parallel and len reaches its
+ * threshold. The counterpart cuts buffers into chunks that depend on len only and combines partial results in
+ * chunk order, so a reduction gives the same bits on every run whatever the number of threads. */
+DLL_LOCAL_VISIBILITY VectorKernels const& kernelsFor(size_t len);
+DLL_LOCAL_VISIBILITY void setParallelPolicy(bool parallel, size_t minLen);
+DLL_LOCAL_VISIBILITY bool isParallelPolicy();
+DLL_LOCAL_VISIBILITY size_t getParallelMinLen();
+
+#endif //PARALLELKERNELS_H
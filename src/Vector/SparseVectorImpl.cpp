@@ -0,0 +1,359 @@
+#include "IVector.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#define MSG_DEFAULT __FUNCTION__
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
+}
+
+namespace {
+    /* Non-zero coordinates kept as index/value pairs sorted by index; zero coordinates are never stored */
+    class SparseVectorImpl : public IVector {
+        public:
+            IVector *clone() const override;
+            ReturnCode setCoord(size_t index, double value) const override;
+            double getCoord(size_t index) const override;
+            double norm(Norm norm) const override;
+            size_t getDim() const override;
+            double const *getData() const override;
+            double *getData() override;
+            ReturnCode getCoords(size_t begin, size_t count, double *dst) const override;
+            ReturnCode setCoords(size_t begin, size_t count, double const *src) const override;
+
+            /* empty vector with room for capacity non-zeros */
+            static SparseVectorImpl *create(size_t dim, size_t capacity);
+            /* a * x + b * y in O(nnz(x) + nnz(y)) */
+            static SparseVectorImpl *lincomb(double a, SparseVectorImpl const *x, double b, SparseVectorImpl const *y);
+
+            /* appends a non-zero past the last stored index; capacity must allow it */
+            void append(size_t index, double value);
+            void scale(double scale);
+            double dot(SparseVectorImpl const *other) const;
+            double dot(double const *dense) const;
+            /* y += a * this over a dense buffer of the same dimension */
+            void axpyInto(double *y, double a) const;
+            /* NORM_1 / NORM_INF distance or squared NORM_2 distance; stops once the partial value reaches bound */
+            double distance(SparseVectorImpl const *other, Norm norm, double bound) const;
+
+            ~SparseVectorImpl();
+
+        private:
+            SparseVectorImpl(size_t dim, size_t capacity, size_t *indices, double *values);
+            size_t lowerBound(size_t index) const;
+            bool reserve(size_t capacity) const;
+
+            size_t dim_;
+            mutable size_t nnz_;
+            mutable size_t capacity_;
+            mutable size_t *indices_;
+            mutable double *values_;
+            ILogger *logger_;
+    };
+}
+
+SparseVectorImpl *SparseVectorImpl::create(size_t dim, size_t capacity) {
+    size_t *indices = nullptr;
+    double *values = nullptr;
+    if (capacity > 0) {
+        indices = new(std::nothrow)size_t[capacity];
+        values = new(std::nothrow)double[capacity];
+        if (indices == nullptr || values == nullptr) {
+            delete[]indices;
+            delete[]values;
+            return nullptr;
+        }
+    }
+
+    SparseVectorImpl *vec = new(std::nothrow)SparseVectorImpl(dim, capacity, indices, values);
+    if (vec == nullptr) {
+        delete[]indices;
+        delete[]values;
+    }
+    return vec;
+} //OK
+
+SparseVectorImpl *SparseVectorImpl::lincomb(double a, SparseVectorImpl const *x, double b, SparseVectorImpl const *y) {
+    SparseVectorImpl *result = SparseVectorImpl::create(x->dim_, x->nnz_ + y->nnz_);
+    if (result == nullptr)
+        return nullptr;
+
+    size_t i = 0, j = 0;
+    while (i < x->nnz_ || j < y->nnz_) {
+        if (j == y->nnz_ || (i < x->nnz_ && x->indices_[i] < y->indices_[j])) {
+            result->append(x->indices_[i], a * x->values_[i]);
+            ++i;
+        } else if (i == x->nnz_ || y->indices_[j] < x->indices_[i]) {
+            result->append(y->indices_[j], b * y->values_[j]);
+            ++j;
+        } else {
+            result->append(x->indices_[i], a * x->values_[i] + b * y->values_[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+} //OK
+
+SparseVectorImpl::SparseVectorImpl(size_t dim, size_t capacity, size_t *indices, double *values) : dim_{dim}, nnz_{0}, capacity_{capacity},
+                                                                                                   indices_{indices}, values_{values} {
+    this->logger_ = ILogger::createLogger(this);
+} //OK
+
+SparseVectorImpl::~SparseVectorImpl() {
+    delete[]this->indices_;
+    this->indices_ = nullptr;
+    delete[]this->values_;
+    this->values_ = nullptr;
+    if (this->logger_ != nullptr)
+        this->logger_->releaseLogger(this);
+} //OK
+
+size_t SparseVectorImpl::lowerBound(size_t index) const {
+    return std::lower_bound(this->indices_, this->indices_ + this->nnz_, index) - this->indices_;
+} //OK
+
+bool SparseVectorImpl::reserve(size_t capacity) const {
+    if (capacity <= this->capacity_)
+        return true;
+
+    size_t *indices = new(std::nothrow)size_t[capacity];
+    double *values = new(std::nothrow)double[capacity];
+    if (indices == nullptr || values == nullptr) {
+        delete[]indices;
+        delete[]values;
+        return false;
+    }
+    if (this->nnz_ > 0) {
+        std::memcpy(indices, this->indices_, this->nnz_ * sizeof(size_t));
+        std::memcpy(values, this->values_, this->nnz_ * sizeof(double));
+    }
+    delete[]this->indices_;
+    delete[]this->values_;
+    this->indices_ = indices;
+    this->values_ = values;
+    this->capacity_ = capacity;
+    return true;
+} //OK
+
+void SparseVectorImpl::append(size_t index, double value) {
+    if (value == 0)
+        return;
+    this->indices_[this->nnz_] = index;
+    this->values_[this->nnz_] = value;
+    this->nnz_++;
+} //OK
+
+IVector *SparseVectorImpl::clone() const {
+    SparseVectorImpl *cloned = SparseVectorImpl::create(this->dim_, this->nnz_);
+    if (cloned == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    if (this->nnz_ > 0) {
+        std::memcpy(cloned->indices_, this->indices_, this->nnz_ * sizeof(size_t));
+        std::memcpy(cloned->values_, this->values_, this->nnz_ * sizeof(double));
+    }
+    cloned->nnz_ = this->nnz_;
+    return cloned;
+} //OK
+
+ReturnCode SparseVectorImpl::setCoord(size_t index, double value) const {
+    if (index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    if (std::isnan(value)) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+
+    size_t pos = this->lowerBound(index);
+    bool stored = pos < this->nnz_ && this->indices_[pos] == index;
+    if (stored && value != 0) {
+        this->values_[pos] = value;
+    } else if (stored) {
+        std::memmove(this->indices_ + pos, this->indices_ + pos + 1, (this->nnz_ - pos - 1) * sizeof(size_t));
+        std::memmove(this->values_ + pos, this->values_ + pos + 1, (this->nnz_ - pos - 1) * sizeof(double));
+        this->nnz_--;
+    } else if (value != 0) {
+        if (this->nnz_ == this->capacity_ && !this->reserve(this->capacity_ < 4 ? 4 : 2 * this->capacity_)) {
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+            return ReturnCode::RC_NO_MEM;
+        }
+        std::memmove(this->indices_ + pos + 1, this->indices_ + pos, (this->nnz_ - pos) * sizeof(size_t));
+        std::memmove(this->values_ + pos + 1, this->values_ + pos, (this->nnz_ - pos) * sizeof(double));
+        this->indices_[pos] = index;
+        this->values_[pos] = value;
+        this->nnz_++;
+    }
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+double SparseVectorImpl::getCoord(size_t index) const {
+    if (index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return NAN;
+    }
+    size_t pos = this->lowerBound(index);
+    return pos < this->nnz_ && this->indices_[pos] == index ? this->values_[pos] : 0;
+} //OK
+
+double SparseVectorImpl::norm(IVector::Norm norm) const {
+    double vec_norm = 0;
+    switch (norm) {
+        case IVector::Norm::NORM_1:
+            for (size_t i = 0; i < this->nnz_; ++i)
+                vec_norm += std::fabs(this->values_[i]);
+            break;
+        case IVector::Norm::NORM_2:
+            for (size_t i = 0; i < this->nnz_; ++i)
+                vec_norm += this->values_[i] * this->values_[i];
+            vec_norm = std::sqrt(vec_norm);
+            break;
+        case IVector::Norm::NORM_INF:
+            for (size_t i = 0; i < this->nnz_; ++i)
+                vec_norm = std::fabs(this->values_[i]) > vec_norm ? std::fabs(this->values_[i]) : vec_norm;
+            break;
+        default:
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+            vec_norm = std::nan("1");
+            break;
+    }
+    return vec_norm;
+} //OK
+
+size_t SparseVectorImpl::getDim() const {
+    return this->dim_;
+} //OK
+
+double const *SparseVectorImpl::getData() const {
+    return nullptr;
+} //OK
+
+double *SparseVectorImpl::getData() {
+    return nullptr;
+} //OK
+
+ReturnCode SparseVectorImpl::getCoords(size_t begin, size_t count, double *dst) const {
+    if (dst == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    std::fill(dst, dst + count, 0.0);
+    for (size_t pos = this->lowerBound(begin); pos < this->nnz_ && this->indices_[pos] < begin + count; ++pos)
+        dst[this->indices_[pos] - begin] = this->values_[pos];
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode SparseVectorImpl::setCoords(size_t begin, size_t count, double const *src) const {
+    if (src == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    size_t nonZeros = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (std::isnan(src[i])) {
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+            return ReturnCode::RC_NAN;
+        }
+        nonZeros += src[i] != 0;
+    }
+
+    size_t first = this->lowerBound(begin);
+    size_t last = this->lowerBound(begin + count);
+    size_t nnz = this->nnz_ - (last - first) + nonZeros;
+    if (!this->reserve(nnz)) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return ReturnCode::RC_NO_MEM;
+    }
+
+    size_t tail = this->nnz_ - last;
+    std::memmove(this->indices_ + first + nonZeros, this->indices_ + last, tail * sizeof(size_t));
+    std::memmove(this->values_ + first + nonZeros, this->values_ + last, tail * sizeof(double));
+    size_t pos = first;
+    for (size_t i = 0; i < count; ++i) {
+        if (src[i] != 0) {
+            this->indices_[pos] = begin + i;
+            this->values_[pos] = src[i];
+            ++pos;
+        }
+    }
+    this->nnz_ = nnz;
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+void SparseVectorImpl::scale(double scale) {
+    if (scale == 0) {
+        this->nnz_ = 0;
+        return;
+    }
+    for (size_t i = 0; i < this->nnz_; ++i)
+        this->values_[i] *= scale;
+} //OK
+
+double SparseVectorImpl::dot(SparseVectorImpl const *other) const {
+    double prod = 0;
+    size_t i = 0, j = 0;
+    while (i < this->nnz_ && j < other->nnz_) {
+        if (this->indices_[i] < other->indices_[j]) {
+            ++i;
+        } else if (other->indices_[j] < this->indices_[i]) {
+            ++j;
+        } else {
+            prod += this->values_[i++] * other->values_[j++];
+        }
+    }
+    return prod;
+} //OK
+
+double SparseVectorImpl::dot(double const *dense) const {
+    double prod = 0;
+    for (size_t i = 0; i < this->nnz_; ++i)
+        prod += this->values_[i] * dense[this->indices_[i]];
+    return prod;
+} //OK
+
+void SparseVectorImpl::axpyInto(double *y, double a) const {
+    for (size_t i = 0; i < this->nnz_; ++i)
+        y[this->indices_[i]] += a * this->values_[i];
+} //OK
+
+double SparseVectorImpl::distance(SparseVectorImpl const *other, IVector::Norm norm, double bound) const {
+    double dist = 0;
+    size_t i = 0, j = 0;
+    while ((i < this->nnz_ || j < other->nnz_) && dist < bound) {
+        double diff;
+        if (j == other->nnz_ || (i < this->nnz_ && this->indices_[i] < other->indices_[j])) {
+            diff = std::fabs(this->values_[i++]);
+        } else if (i == this->nnz_ || other->indices_[j] < this->indices_[i]) {
+            diff = std::fabs(other->values_[j++]);
+        } else {
+            diff = std::fabs(this->values_[i++] - other->values_[j++]);
+        }
+        switch (norm) {
+            case IVector::Norm::NORM_1:
+                dist += diff;
+                break;
+            case IVector::Norm::NORM_2:
+                dist += diff * diff;
+                break;
+            default:
+                dist = diff > dist ? diff : dist;
+                break;
+        }
+    }
+    return dist;
+} //OK
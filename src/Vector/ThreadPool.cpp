@@ -0,0 +1,93 @@
+#include "ThreadPool.h"
+#include <new>
+
+/* set on the workers and on a caller while it runs chunks, so nested parallelFor calls stay serial */
+static thread_local bool t_insidePool = false;
+
+ThreadPool *ThreadPool::instance() {
+    static ThreadPool *pool = new(std::nothrow) ThreadPool();
+    return pool;
+} //OK
+
+ThreadPool::ThreadPool() : job_{nullptr}, generation_{0} {
+    unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned i = 1; i < hardware; ++i)
+        this->threads_.push_back(std::thread(&ThreadPool::workerLoop, this));
+} //OK
+
+size_t ThreadPool::getConcurrency() const {
+    return this->threads_.size() + 1;
+} //OK
+
+void ThreadPool::runChunks(Job &job) {
+    for (;;) {
+        size_t begin;
+        {
+            std::lock_guard<std::mutex> lock(this->mutex_);
+            begin = job.next;
+            if (begin < job.count)
+                job.next = job.count - begin > job.chunk ? begin + job.chunk : job.count;
+        }
+        if (begin >= job.count)
+            return;
+        size_t end = job.count - begin > job.chunk ? begin + job.chunk : job.count;
+        (*job.body)(begin, end);
+    }
+} //OK
+
+void ThreadPool::workerLoop() {
+    t_insidePool = true;
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    for (;;) {
+        while (this->job_ == nullptr || this->generation_ == seen)
+            this->wakeup_.wait(lock);
+
+        seen = this->generation_;
+        Job *job = this->job_;
+        job->workers++;
+        lock.unlock();
+        this->runChunks(*job);
+        lock.lock();
+        if (--job->workers == 0)
+            this->done_.notify_all();
+    }
+} //OK
+
+void ThreadPool::parallelFor(size_t count, size_t minChunk, std::function<void(size_t, size_t)> const &body) {
+    if (count == 0)
+        return;
+    ThreadPool *pool = ThreadPool::instance();
+    if (pool == nullptr) {
+        body(0, count);
+        return;
+    }
+    pool->run(count, minChunk, body);
+} //OK
+
+void ThreadPool::run(size_t count, size_t minChunk, std::function<void(size_t, size_t)> const &body) {
+    size_t chunk = count / (4 * this->getConcurrency());
+    chunk = chunk > minChunk ? chunk : (minChunk > 0 ? minChunk : 1);
+    if (this->threads_.empty() || t_insidePool || chunk >= count) {
+        body(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(this->submitMutex_);
+    Job job = {&body, count, chunk, 0, 0};
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->job_ = &job;
+        this->generation_++;
+    }
+    this->wakeup_.notify_all();
+
+    t_insidePool = true;
+    this->runChunks(job);
+    t_insidePool = false;
+
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    while (job.workers != 0)
+        this->done_.wait(lock);
+    this->job_ = nullptr;
+} //OK
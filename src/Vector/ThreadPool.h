@@ -0,0 +1,53 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "../Util/Export.h"
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Worker threads shared by the batch kernels, one per hardware thread besides the caller, started on first use.
+ * The pool is never destroyed: joining workers from a static destructor would run under the loader lock when
+ * the library is unloaded, so the idle workers are left for process exit to reclaim. */
+class DLL_LOCAL_VISIBILITY ThreadPool {
+    public:
+        /* runs body over [0, count) cut into contiguous chunks of at least minChunk, on the workers and the
+         * calling thread, and returns once every chunk is done; calls from inside body, and every call when
+         * the pool cannot be allocated, run serially */
+        static void parallelFor(size_t count, size_t minChunk, std::function<void(size_t, size_t)> const& body);
+
+    private:
+        struct Job {
+            std::function<void(size_t, size_t)> const* body;
+            size_t count;
+            size_t chunk;
+            size_t next;
+            size_t workers;
+        };
+
+        /* nullptr when it cannot be allocated */
+        static ThreadPool* instance();
+
+        ThreadPool();
+        ThreadPool(ThreadPool const&)            = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        /* workers plus the calling thread */
+        size_t getConcurrency() const;
+        void run(size_t count, size_t minChunk, std::function<void(size_t, size_t)> const& body);
+        void workerLoop();
+        void runChunks(Job& job);
+
+        std::vector<std::thread> threads_;
+        std::mutex submitMutex_;
+        std::mutex mutex_;
+        std::condition_variable wakeup_;
+        std::condition_variable done_;
+        Job* job_;
+        size_t generation_;
+};
+
+#endif //THREADPOOL_H
@@ -0,0 +1,101 @@
+#include "IVectorArena.h"
+#include <vector>
+#include <new>
+
+#define MSG_DEFAULT __FUNCTION__
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
+}
+
+namespace {
+    class VectorArenaImpl : public IVectorArena {
+        public:
+            void *allocate(size_t size) override;
+            void reset() override;
+            size_t getUsed() const override;
+            size_t getCapacity() const override;
+
+            VectorArenaImpl(size_t blockSize);
+            ~VectorArenaImpl();
+
+        private:
+            static const size_t ALIGNMENT = 16;
+
+            struct Chunk {
+                char *memory;
+                size_t size;
+            };
+
+            bool appendChunk(size_t size);
+
+            size_t blockSize_;
+            std::vector<Chunk> chunks_;
+            size_t current_;
+            size_t offset_;
+            size_t used_;
+            size_t capacity_;
+            ILogger *logger_;
+    };
+}
+
+VectorArenaImpl::VectorArenaImpl(size_t blockSize) : blockSize_{blockSize}, current_{0}, offset_{0}, used_{0}, capacity_{0} {
+    this->logger_ = ILogger::createLogger(this);
+} //OK
+
+VectorArenaImpl::~VectorArenaImpl() {
+    for (std::vector<Chunk>::iterator it = this->chunks_.begin(); it < this->chunks_.end(); ++it)
+        delete[]it->memory;
+    this->chunks_.clear();
+    if (this->logger_ != nullptr)
+        this->logger_->releaseLogger(this);
+} //OK
+
+bool VectorArenaImpl::appendChunk(size_t size) {
+    Chunk chunk;
+    chunk.size = size > this->blockSize_ ? size : this->blockSize_;
+    chunk.memory = new(std::nothrow) char[chunk.size];
+    if (chunk.memory == nullptr)
+        return false;
+
+    this->chunks_.push_back(chunk);
+    this->capacity_ += chunk.size;
+    return true;
+} //OK
+
+void *VectorArenaImpl::allocate(size_t size) {
+    size_t padded = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (padded < size) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+
+    while (this->current_ < this->chunks_.size() && this->chunks_[this->current_].size - this->offset_ < padded) {
+        this->current_++;
+        this->offset_ = 0;
+    }
+    if (this->current_ == this->chunks_.size() && !this->appendChunk(padded)) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+
+    void *ptr = this->chunks_[this->current_].memory + this->offset_;
+    this->offset_ += padded;
+    this->used_ += padded;
+    return ptr;
+} //OK
+
+void VectorArenaImpl::reset() {
+    this->current_ = 0;
+    this->offset_ = 0;
+    this->used_ = 0;
+} //OK
+
+size_t VectorArenaImpl::getUsed() const {
+    return this->used_;
+} //OK
+
+size_t VectorArenaImpl::getCapacity() const {
+    return this->capacity_;
+} //OK
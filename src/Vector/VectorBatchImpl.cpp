@@ -0,0 +1,120 @@
+#include "IVectorBatch.h"
+#include <cmath>
+#include <new>
+
+#define MSG_DEFAULT __FUNCTION__
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
+}
+
+namespace {
+    class VectorBatchImpl : public IVectorBatch {
+        public:
+            IVectorBatch *clone() const override;
+            IVector *getVector(size_t ind) const override;
+            ReturnCode setVector(size_t ind, IVector const *vector) override;
+            ReturnCode setCoord(size_t ind, size_t index, double value) override;
+            double getCoord(size_t ind, size_t index) const override;
+            double const *getData() const override;
+            size_t getDim() const override;
+            size_t getSize() const override;
+
+            VectorBatchImpl(size_t size, size_t dim, double *data);
+            ~VectorBatchImpl();
+
+        private:
+            size_t size_;
+            size_t dim_;
+            double *data_;
+            ILogger *logger_;
+    };
+}
+
+VectorBatchImpl::VectorBatchImpl(size_t size, size_t dim, double *data) : size_{size}, dim_{dim}, data_{data} {
+    this->logger_ = ILogger::createLogger(this);
+} //OK
+
+VectorBatchImpl::~VectorBatchImpl() {
+    delete[]this->data_;
+    this->data_ = nullptr;
+    if (this->logger_ != nullptr)
+        this->logger_->releaseLogger(this);
+} //OK
+
+IVectorBatch *VectorBatchImpl::clone() const {
+    size_t len = this->size_ * this->dim_;
+    double *clonedData = new(std::nothrow)double[len];
+    if (clonedData == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    for (size_t i = 0; i < len; ++i)
+        clonedData[i] = this->data_[i];
+
+    VectorBatchImpl *cloned = new(std::nothrow)VectorBatchImpl(this->size_, this->dim_, clonedData);
+    if (cloned == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        delete[]clonedData;
+    }
+    return cloned;
+} //OK
+
+IVector *VectorBatchImpl::getVector(size_t ind) const {
+    if (ind >= this->size_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return nullptr;
+    }
+    return IVector::createVector(this->dim_, this->data_ + ind * this->dim_, this->logger_);
+} //OK
+
+ReturnCode VectorBatchImpl::setVector(size_t ind, IVector const *vector) {
+    if (vector == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (vector->getDim() != this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+    if (ind >= this->size_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+
+    return vector->getCoords(0, this->dim_, this->data_ + ind * this->dim_);
+} //OK
+
+ReturnCode VectorBatchImpl::setCoord(size_t ind, size_t index, double value) {
+    if (ind >= this->size_ || index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    if (std::isnan(value)) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+    this->data_[ind * this->dim_ + index] = value;
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+double VectorBatchImpl::getCoord(size_t ind, size_t index) const {
+    if (ind >= this->size_ || index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return NAN;
+    }
+    return this->data_[ind * this->dim_ + index];
+} //OK
+
+double const *VectorBatchImpl::getData() const {
+    return this->data_;
+} //OK
+
+size_t VectorBatchImpl::getDim() const {
+    return this->dim_;
+} //OK
+
+size_t VectorBatchImpl::getSize() const {
+    return this->size_;
+} //OK
@@ -0,0 +1,88 @@
+#include "VectorHash.h"
+#include <cmath>
+#include <cstring>
+
+/* coordinates quantized per pass of hashCells, so the quantization loop stays branch-free and vectorizable */
+static const size_t HASH_BLOCK = 64;
+
+namespace {
+    /* splitmix64 finalizer */
+    uint64_t mixBits(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /* index of the cell holding coord shifted by offset cells */
+    double cellOf(double coord, double scale, double offset) {
+        return std::floor(coord * scale + offset) + 0.0;
+    }
+
+    uint64_t cellHash(size_t index, double cell) {
+        uint64_t bits;
+        std::memcpy(&bits, &cell, sizeof(bits));
+        return mixBits(bits + (index + 1) * 0x9e3779b97f4a7c15ULL);
+    }
+}
+
+ReturnCode checkGrid(double cellSize, double tolerance) {
+    if (std::isnan(cellSize) || std::isnan(tolerance))
+        return ReturnCode::RC_NAN;
+    if (!(cellSize > 0) || std::isinf(cellSize) || tolerance < 0 || tolerance > cellSize / 2)
+        return ReturnCode::RC_INVALID_PARAMS;
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+size_t deltaLimit(size_t capacity) {
+    size_t n = 0;
+    while (n < 63 && (static_cast<size_t>(2) << n) <= capacity)
+        ++n;
+    return n;
+} //OK
+
+uint64_t hashCells(double const *coords, size_t begin, size_t count, double scale) {
+    double cells[HASH_BLOCK];
+    uint64_t sum = 0;
+    for (size_t done = 0; done < count; done += HASH_BLOCK) {
+        size_t len = count - done < HASH_BLOCK ? count - done : HASH_BLOCK;
+        for (size_t i = 0; i < len; ++i)
+            cells[i] = cellOf(coords[done + i], scale, 0);
+        for (size_t i = 0; i < len; ++i)
+            sum += cellHash(begin + done + i, cells[i]);
+    }
+    return sum;
+} //OK
+
+uint64_t finishKey(uint64_t sum) {
+    return mixBits(sum);
+} //OK
+
+size_t cellDeltas(double const *coords, size_t begin, size_t count, double scale, double reach, uint64_t *deltas, size_t found, size_t max) {
+    for (size_t i = 0; i < count; ++i) {
+        double cell = cellOf(coords[i], scale, 0);
+        double low = cellOf(coords[i], scale, -reach);
+        double high = cellOf(coords[i], scale, reach);
+        double other = low != cell ? low : high;
+        if (other == cell)
+            continue;
+        if (found < max)
+            deltas[found] = cellHash(begin + i, other) - cellHash(begin + i, cell);
+        ++found;
+    }
+    return found;
+} //OK
+
+void expandKeys(uint64_t sum, uint64_t const *deltas, size_t n, uint64_t *keys) {
+    keys[0] = sum;
+    size_t count = 1;
+    for (size_t d = 0; d < n; ++d) {
+        for (size_t j = 0; j < count; ++j)
+            keys[count + j] = keys[j] + deltas[d];
+        count *= 2;
+    }
+    for (size_t j = 0; j < count; ++j)
+        keys[j] = finishKey(keys[j]);
+} //OK
@@ -0,0 +1,29 @@
+#ifndef VECTORHASH_H
+#define VECTORHASH_H
+
+#include "../Util/Export.h"
+#include "../Util/ReturnCode.h"
+#include <cstddef> // size_t
+#include <cstdint>
+
+/* Coordinates are quantized to a grid of side 1 / scale, and a key is the mixed sum of one hash per
+ * (coordinate index, cell). Being a sum, the key of a neighbouring cell is the key sum plus one delta
+ * per coordinate that moves. */
+
+/* validates a grid side and a neighbour tolerance, which may not exceed half a cell */
+DLL_LOCAL_VISIBILITY ReturnCode checkGrid(double cellSize, double tolerance);
+/* largest n with 2^n <= capacity, at most 63 */
+DLL_LOCAL_VISIBILITY size_t deltaLimit(size_t capacity);
+/* hash sum of coordinates [begin, begin + count), coords pointing at coordinate begin */
+DLL_LOCAL_VISIBILITY uint64_t hashCells(double const* coords, size_t begin, size_t count, double scale);
+/* 64-bit key of a full hash sum */
+DLL_LOCAL_VISIBILITY uint64_t finishKey(uint64_t sum);
+/* for each coordinate of [begin, begin + count) whose interval of half-width reach cells also covers the next or
+ * previous cell, the change of the hash sum when it moves there; reach must not exceed 0.5. Stores up to
+ * max - found of them after deltas[found] and returns the new total, which keeps counting past max */
+DLL_LOCAL_VISIBILITY size_t cellDeltas(double const* coords, size_t begin, size_t count, double scale, double reach,
+                                       uint64_t* deltas, size_t found, size_t max);
+/* the 2^n keys reached from sum by applying any subset of deltas, the unmoved one first */
+DLL_LOCAL_VISIBILITY void expandKeys(uint64_t sum, uint64_t const* deltas, size_t n, uint64_t* keys);
+
+#endif //VECTORHASH_H
@@ -1,11 +1,18 @@
 #include "IVector.h"
+#include "IVectorArena.h"
+#include "ParallelKernels.h"
+#include "VectorPool.h"
+#include <atomic>
 #include <cmath>
+#include <cstring>
 #include <new>
+#include <limits>
 
 #define MSG_DEFAULT __FUNCTION__
-#define VECLOG(logger, msg, rc)\
-if (logger != nullptr) {\
-    logger->log(msg, rc);\
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
 }
 
 namespace {
@@ -16,42 +23,220 @@ namespace {
             double getCoord(size_t index) const override;
             double norm(Norm norm) const override;
             size_t getDim() const override;
+            double const *getData() const override;
+            double *getData() override;
+            ReturnCode getCoords(size_t begin, size_t count, double *dst) const override;
+            ReturnCode setCoords(size_t begin, size_t count, double const *src) const override;
+
+            /* heap vectors of at least this dimension keep their coordinates in a reference-counted buffer
+             * that clones share until one of them is written; smaller ones are cheaper to copy */
+            static const size_t SHARED_MIN_DIM = 64;
+
+            /* header and coordinates share one allocation, taken from arena when it is not null,
+             * except for shared heap buffers; coordinates are left uninitialised */
+            static VectorImpl *create(size_t dim, IVectorArena *arena = nullptr, ILogger *logger = nullptr);
+            /* heap header over a new[]'d coordinate buffer that the vector releases on destruction */
+            static VectorImpl *adopt(size_t dim, double *data);
+            static void operator delete(void *ptr);
+
+            /* mutable coordinates for library code that is done writing them before it returns;
+             * unlike getData() it leaves the buffer shareable and norms memoized */
+            double *writeData();
 
-            VectorImpl(size_t dim, double *data);
             ~VectorImpl();
 
         private:
+            /* precedes every VectorImpl and records where its block came from */
+            struct BlockHeader {
+                IVectorArena *arena;
+                /* inline coordinates, and whether the heap block goes back to the VectorPool */
+                size_t dim;
+                bool pooled;
+            };
+
+            /* precedes the coordinates of a shared buffer */
+            struct SharedBuffer {
+                std::atomic<size_t> refs;
+                size_t dim;
+                bool pooled;
+            };
+
+            static const size_t NORM_COUNT = 3;
+
+            /* storage for a VectorImpl followed by dim coordinates, its BlockHeader already filled in */
+            static void *allocateBlock(size_t dim, IVectorArena *arena);
+            static size_t blockSize(size_t dim);
+            static size_t sharedSize(size_t dim);
+            static SharedBuffer *allocateShared(size_t dim);
+            static void releaseShared(SharedBuffer *shared);
+
+            VectorImpl(size_t dim, double *data, SharedBuffer *shared, bool adopted, IVectorArena *arena, ILogger *logger);
+            BlockHeader const *getBlockHeader() const;
+            /* gives this vector a private copy of a shared buffer before a write */
+            bool makeUnique() const;
+            double computeNorm(Norm norm) const;
+            void invalidateNorms() const;
+
             size_t dim_;
-            double *data_;
+            mutable double *data_;
+            mutable SharedBuffer *shared_;
+            bool adopted_;
+            /* set once the mutable getData() pointer is handed out: the coordinates may then change at any
+             * time, so clones get their own copy and norms are no longer memoized */
+            bool exposed_;
             ILogger *logger_;
+            /* memoized norm per Norm value, NaN until computed; cleared by every write path */
+            mutable std::atomic<double> norms_[NORM_COUNT];
     };
 }
 
-VectorImpl::VectorImpl(size_t dim, double *data) : dim_{dim}, data_{data} {
-    this->logger_ = ILogger::createLogger(this);
+size_t VectorImpl::blockSize(size_t dim) {
+    return sizeof(BlockHeader) + sizeof(VectorImpl) + dim * sizeof(double);
+} //OK
+
+size_t VectorImpl::sharedSize(size_t dim) {
+    return sizeof(SharedBuffer) + dim * sizeof(double);
+} //OK
+
+void *VectorImpl::allocateBlock(size_t dim, IVectorArena *arena) {
+    if (dim > (std::numeric_limits<size_t>::max() - VectorImpl::blockSize(0)) / sizeof(double))
+        return nullptr;
+
+    size_t size = VectorImpl::blockSize(dim);
+    bool pooled = false;
+    void *block = arena != nullptr ? arena->allocate(size) : VectorPool::instance().allocate(dim, VectorPool::POOL_BLOCK, size, pooled);
+    if (block == nullptr)
+        return nullptr;
+
+    BlockHeader *header = static_cast<BlockHeader *>(block);
+    header->arena = arena;
+    header->dim = dim;
+    header->pooled = pooled;
+    return header + 1;
+} //OK
+
+VectorImpl::SharedBuffer *VectorImpl::allocateShared(size_t dim) {
+    if (dim > (std::numeric_limits<size_t>::max() - VectorImpl::sharedSize(0)) / sizeof(double))
+        return nullptr;
+
+    bool pooled = false;
+    void *memory = VectorPool::instance().allocate(dim, VectorPool::POOL_BUFFER, VectorImpl::sharedSize(dim), pooled);
+    if (memory == nullptr)
+        return nullptr;
+
+    SharedBuffer *shared = new(memory) SharedBuffer;
+    shared->refs.store(1, std::memory_order_relaxed);
+    shared->dim = dim;
+    shared->pooled = pooled;
+    return shared;
+} //OK
+
+void VectorImpl::releaseShared(SharedBuffer *shared) {
+    if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        size_t dim = shared->dim;
+        bool pooled = shared->pooled;
+        shared->~SharedBuffer();
+        if (pooled)
+            VectorPool::instance().release(shared, dim, VectorPool::POOL_BUFFER, VectorImpl::sharedSize(dim));
+        else
+            ::operator delete(shared);
+    }
+} //OK
+
+VectorImpl *VectorImpl::create(size_t dim, IVectorArena *arena, ILogger *logger) {
+    if (arena != nullptr || dim < SHARED_MIN_DIM) {
+        void *block = VectorImpl::allocateBlock(dim, arena);
+        if (block == nullptr)
+            return nullptr;
+        VectorImpl *vec = static_cast<VectorImpl *>(block);
+        return new(vec) VectorImpl(dim, reinterpret_cast<double *>(vec + 1), nullptr, false, arena, logger);
+    }
+
+    SharedBuffer *shared = VectorImpl::allocateShared(dim);
+    if (shared == nullptr)
+        return nullptr;
+    void *block = VectorImpl::allocateBlock(0, nullptr);
+    if (block == nullptr) {
+        VectorImpl::releaseShared(shared);
+        return nullptr;
+    }
+    return new(block) VectorImpl(dim, reinterpret_cast<double *>(shared + 1), shared, false, nullptr, logger);
+} //OK
+
+VectorImpl *VectorImpl::adopt(size_t dim, double *data) {
+    void *block = VectorImpl::allocateBlock(0, nullptr);
+    if (block == nullptr)
+        return nullptr;
+    return new(block) VectorImpl(dim, data, nullptr, true, nullptr, nullptr);
+} //OK
+
+void VectorImpl::operator delete(void *ptr) {
+    BlockHeader *header = static_cast<BlockHeader *>(ptr) - 1;
+    if (header->arena != nullptr)
+        return;
+    if (header->pooled)
+        VectorPool::instance().release(header, header->dim, VectorPool::POOL_BLOCK, VectorImpl::blockSize(header->dim));
+    else
+        ::operator delete(header);
+} //OK
+
+VectorImpl::VectorImpl(size_t dim, double *data, SharedBuffer *shared, bool adopted, IVectorArena *arena, ILogger *logger) : dim_{dim}, data_{data},
+                                                                                                                           shared_{shared}, adopted_{adopted},
+                                                                                                                           exposed_{false}, logger_{logger} {
+    this->invalidateNorms();
+    if (arena == nullptr)
+        this->logger_ = ILogger::createLogger(this);
 } //OK
 
 VectorImpl::~VectorImpl() {
-    delete[]this->data_;
+    if (this->adopted_)
+        delete[]this->data_;
+    if (this->shared_ != nullptr)
+        VectorImpl::releaseShared(this->shared_);
+    this->shared_ = nullptr;
     this->data_ = nullptr;
-    if (this->logger_ != nullptr)
+    if (this->getBlockHeader()->arena == nullptr && this->logger_ != nullptr)
         this->logger_->releaseLogger(this);
 } //OK
 
+VectorImpl::BlockHeader const *VectorImpl::getBlockHeader() const {
+    return reinterpret_cast<BlockHeader const *>(this) - 1;
+} //OK
+
+bool VectorImpl::makeUnique() const {
+    if (this->shared_ == nullptr || this->shared_->refs.load(std::memory_order_acquire) == 1)
+        return true;
+
+    SharedBuffer *copy = VectorImpl::allocateShared(this->dim_);
+    if (copy == nullptr)
+        return false;
+    double *coords = reinterpret_cast<double *>(copy + 1);
+    std::memcpy(coords, this->data_, this->dim_ * sizeof(double));
+    VectorImpl::releaseShared(this->shared_);
+    this->shared_ = copy;
+    this->data_ = coords;
+    return true;
+} //OK
+
 IVector *VectorImpl::clone() const {
-    double *clonedCoords = new(std::nothrow)double[this->dim_];
-    if (clonedCoords == nullptr) {
-        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        return nullptr;
+    VectorImpl *cloned = nullptr;
+    if (this->shared_ != nullptr && !this->exposed_) {
+        void *block = VectorImpl::allocateBlock(0, nullptr);
+        if (block != nullptr) {
+            this->shared_->refs.fetch_add(1, std::memory_order_relaxed);
+            cloned = new(block) VectorImpl(this->dim_, this->data_, this->shared_, false, nullptr, nullptr);
+        }
+    } else {
+        cloned = VectorImpl::create(this->dim_);
+        if (cloned != nullptr)
+            std::memcpy(cloned->data_, this->data_, this->dim_ * sizeof(double));
     }
-    for (size_t i = 0; i < this->dim_; i++)
-        clonedCoords[i] = this->data_[i];
-
-    VectorImpl *cloned = new(std::nothrow)VectorImpl(this->dim_, clonedCoords);
     if (cloned == nullptr) {
         VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
-        delete[]clonedCoords;
+        return nullptr;
     }
+    for (size_t i = 0; i < NORM_COUNT; ++i)
+        cloned->norms_[i].store(this->norms_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
     return cloned;
 } //OK
 
@@ -64,7 +249,12 @@ ReturnCode VectorImpl::setCoord(size_t index, double value) const {
         VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
         return ReturnCode::RC_NAN;
     }
+    if (!this->makeUnique()) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return ReturnCode::RC_NO_MEM;
+    }
     this->data_[index] = value;
+    this->invalidateNorms();
     return ReturnCode::RC_SUCCESS;
 } //OK
 
@@ -78,26 +268,36 @@ double VectorImpl::getCoord(size_t index) const {
 } //OK
 
 
+void VectorImpl::invalidateNorms() const {
+    for (size_t i = 0; i < NORM_COUNT; ++i)
+        this->norms_[i].store(NAN, std::memory_order_relaxed);
+} //OK
+
 double VectorImpl::norm(IVector::Norm norm) const {
+    size_t slot = static_cast<size_t>(norm);
+    if (slot >= NORM_COUNT)
+        return this->computeNorm(norm);
+
+    double vec_norm = this->norms_[slot].load(std::memory_order_relaxed);
+    if (std::isnan(vec_norm)) {
+        vec_norm = this->computeNorm(norm);
+        if (!this->exposed_)
+            this->norms_[slot].store(vec_norm, std::memory_order_relaxed);
+    }
+    return vec_norm;
+} //OK
+
+double VectorImpl::computeNorm(IVector::Norm norm) const {
     double vec_norm = 0;
     switch (norm) {
         case IVector::Norm::NORM_1:
-            for (int i = 0; i < this->dim_; ++i) {
-                vec_norm += fabs(this->data_[i]);
-            }
+            vec_norm = kernelsFor(this->dim_).norm1(this->data_, this->dim_);
             break;
         case IVector::Norm::NORM_2:
-            for (int i = 0; i < this->dim_; ++i) {
-                vec_norm += this->data_[i] * this->data_[i];
-            }
-            vec_norm = sqrt(vec_norm);
+            vec_norm = sqrt(kernelsFor(this->dim_).sumSquares(this->data_, this->dim_));
             break;
         case IVector::Norm::NORM_INF:
-            vec_norm = fabs(this->data_[0]);
-            for (int i = 1; i < this->dim_; ++i) {
-                if (fabs(this->data_[i]) > vec_norm)
-                    vec_norm = fabs(this->data_[i]);
-            }
+            vec_norm = kernelsFor(this->dim_).normInf(this->data_, this->dim_);
             break;
         default:
             VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
@@ -107,6 +307,63 @@ double VectorImpl::norm(IVector::Norm norm) const {
     return vec_norm;
 } //OK
 
+double const *VectorImpl::getData() const {
+    return this->data_;
+} //OK
+
+double *VectorImpl::getData() {
+    double *data = this->writeData();
+    if (data != nullptr)
+        this->exposed_ = true;
+    return data;
+} //OK
+
+double *VectorImpl::writeData() {
+    if (!this->makeUnique()) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    this->invalidateNorms();
+    return this->data_;
+} //OK
+
+ReturnCode VectorImpl::getCoords(size_t begin, size_t count, double *dst) const {
+    if (dst == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    std::memcpy(dst, this->data_ + begin, count * sizeof(double));
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode VectorImpl::setCoords(size_t begin, size_t count, double const *src) const {
+    if (src == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (std::isnan(src[i])) {
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+            return ReturnCode::RC_NAN;
+        }
+    }
+    if (!this->makeUnique()) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NO_MEM);
+        return ReturnCode::RC_NO_MEM;
+    }
+    std::memmove(this->data_ + begin, src, count * sizeof(double));
+    this->invalidateNorms();
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
 size_t VectorImpl::getDim() const {
     return this->dim_;
 } //OK
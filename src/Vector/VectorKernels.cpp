@@ -0,0 +1,519 @@
+#include "VectorKernels.h"
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+    double norm1Scalar(double const *data, size_t len) {
+        double acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            acc0 += std::fabs(data[i]);
+            acc1 += std::fabs(data[i + 1]);
+            acc2 += std::fabs(data[i + 2]);
+            acc3 += std::fabs(data[i + 3]);
+        }
+        for (; i < len; ++i)
+            acc0 += std::fabs(data[i]);
+        return (acc0 + acc1) + (acc2 + acc3);
+    }
+
+    double sumSquaresScalar(double const *data, size_t len) {
+        double acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            acc0 += data[i] * data[i];
+            acc1 += data[i + 1] * data[i + 1];
+            acc2 += data[i + 2] * data[i + 2];
+            acc3 += data[i + 3] * data[i + 3];
+        }
+        for (; i < len; ++i)
+            acc0 += data[i] * data[i];
+        return (acc0 + acc1) + (acc2 + acc3);
+    }
+
+    double normInfScalar(double const *data, size_t len) {
+        double max = 0;
+        for (size_t i = 0; i < len; ++i) {
+            double abs = std::fabs(data[i]);
+            if (abs > max)
+                max = abs;
+        }
+        return max;
+    }
+
+    double dotScalar(double const *data1, double const *data2, size_t len) {
+        double acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            acc0 += data1[i] * data2[i];
+            acc1 += data1[i + 1] * data2[i + 1];
+            acc2 += data1[i + 2] * data2[i + 2];
+            acc3 += data1[i + 3] * data2[i + 3];
+        }
+        for (; i < len; ++i)
+            acc0 += data1[i] * data2[i];
+        return (acc0 + acc1) + (acc2 + acc3);
+    }
+
+    void dotBlockScalar(double const *lhs, double const *rhs, size_t stride, size_t len, double *out) {
+        double acc[DOT_BLOCK][DOT_BLOCK] = {};
+        for (size_t k = 0; k < len; ++k) {
+            double a0 = lhs[k], a1 = lhs[stride + k], a2 = lhs[2 * stride + k], a3 = lhs[3 * stride + k];
+            for (size_t c = 0; c < DOT_BLOCK; ++c) {
+                double b = rhs[c * stride + k];
+                acc[0][c] += a0 * b;
+                acc[1][c] += a1 * b;
+                acc[2][c] += a2 * b;
+                acc[3][c] += a3 * b;
+            }
+        }
+        for (size_t r = 0; r < DOT_BLOCK; ++r) {
+            for (size_t c = 0; c < DOT_BLOCK; ++c)
+                out[r * DOT_BLOCK + c] = acc[r][c];
+        }
+    }
+
+    double distance1Scalar(double const *data1, double const *data2, size_t len, double bound) {
+        double sum = 0;
+        for (size_t begin = 0; begin < len && sum < bound; begin += DISTANCE_BLOCK) {
+            size_t end = begin + DISTANCE_BLOCK < len ? begin + DISTANCE_BLOCK : len;
+            double acc0 = 0, acc1 = 0;
+            size_t i = begin;
+            for (; i + 2 <= end; i += 2) {
+                acc0 += std::fabs(data1[i] - data2[i]);
+                acc1 += std::fabs(data1[i + 1] - data2[i + 1]);
+            }
+            for (; i < end; ++i)
+                acc0 += std::fabs(data1[i] - data2[i]);
+            sum += acc0 + acc1;
+        }
+        return sum;
+    }
+
+    double distance2SquaredScalar(double const *data1, double const *data2, size_t len, double bound) {
+        double sum = 0;
+        for (size_t begin = 0; begin < len && sum < bound; begin += DISTANCE_BLOCK) {
+            size_t end = begin + DISTANCE_BLOCK < len ? begin + DISTANCE_BLOCK : len;
+            double acc0 = 0, acc1 = 0;
+            size_t i = begin;
+            for (; i + 2 <= end; i += 2) {
+                double diff0 = data1[i] - data2[i];
+                double diff1 = data1[i + 1] - data2[i + 1];
+                acc0 += diff0 * diff0;
+                acc1 += diff1 * diff1;
+            }
+            for (; i < end; ++i)
+                acc0 += (data1[i] - data2[i]) * (data1[i] - data2[i]);
+            sum += acc0 + acc1;
+        }
+        return sum;
+    }
+
+    double distanceInfScalar(double const *data1, double const *data2, size_t len, double bound) {
+        double max = 0;
+        for (size_t i = 0; i < len && max < bound; ++i) {
+            double abs = std::fabs(data1[i] - data2[i]);
+            if (abs > max || std::isnan(abs))
+                max = abs;
+        }
+        return max;
+    }
+
+    void axpyScalar(double *y, double a, double const *x, size_t len) {
+        for (size_t i = 0; i < len; ++i)
+            y[i] += a * x[i];
+    }
+
+    void axpbyScalar(double *dst, double a, double const *x, double b, double const *y, size_t len) {
+        for (size_t i = 0; i < len; ++i)
+            dst[i] = a * x[i] + b * y[i];
+    }
+
+    void scaleScalar(double *data, double a, size_t len) {
+        for (size_t i = 0; i < len; ++i)
+            data[i] *= a;
+    }
+
+#ifdef VECTOR_KERNELS_X86
+    /* SSE2: 2 lanes, two independent accumulators */
+
+    __attribute__((target("sse2"))) double hsumSse2(__m128d v) {
+        return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+    }
+
+    __attribute__((target("sse2"))) double hmaxSse2(__m128d v) {
+        return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v)));
+    }
+
+    __attribute__((target("sse2"))) double norm1Sse2(double const *data, size_t len) {
+        __m128d const mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            acc0 = _mm_add_pd(acc0, _mm_and_pd(_mm_loadu_pd(data + i), mask));
+            acc1 = _mm_add_pd(acc1, _mm_and_pd(_mm_loadu_pd(data + i + 2), mask));
+        }
+        double sum = hsumSse2(_mm_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += std::fabs(data[i]);
+        return sum;
+    }
+
+    __attribute__((target("sse2"))) double sumSquaresSse2(double const *data, size_t len) {
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            __m128d v0 = _mm_loadu_pd(data + i);
+            __m128d v1 = _mm_loadu_pd(data + i + 2);
+            acc0 = _mm_add_pd(acc0, _mm_mul_pd(v0, v0));
+            acc1 = _mm_add_pd(acc1, _mm_mul_pd(v1, v1));
+        }
+        double sum = hsumSse2(_mm_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += data[i] * data[i];
+        return sum;
+    }
+
+    __attribute__((target("sse2"))) double normInfSse2(double const *data, size_t len) {
+        __m128d const mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+        __m128d acc = _mm_setzero_pd();
+        size_t i = 0;
+        for (; i + 2 <= len; i += 2)
+            acc = _mm_max_pd(acc, _mm_and_pd(_mm_loadu_pd(data + i), mask));
+        double max = hmaxSse2(acc);
+        for (; i < len; ++i) {
+            if (std::fabs(data[i]) > max)
+                max = std::fabs(data[i]);
+        }
+        return max;
+    }
+
+    __attribute__((target("sse2"))) double dotSse2(double const *data1, double const *data2, size_t len) {
+        __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4) {
+            acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(data1 + i), _mm_loadu_pd(data2 + i)));
+            acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(data1 + i + 2), _mm_loadu_pd(data2 + i + 2)));
+        }
+        double sum = hsumSse2(_mm_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += data1[i] * data2[i];
+        return sum;
+    }
+
+    /* AVX2 + FMA: 4 lanes, two independent accumulators */
+
+    __attribute__((target("avx2,fma"))) double hsumAvx2(__m256d v) {
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+
+    __attribute__((target("avx2,fma"))) double hmaxAvx2(__m256d v) {
+        __m128d half = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_max_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+
+    __attribute__((target("avx2,fma"))) double norm1Avx2(double const *data, size_t len) {
+        __m256d const mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            acc0 = _mm256_add_pd(acc0, _mm256_and_pd(_mm256_loadu_pd(data + i), mask));
+            acc1 = _mm256_add_pd(acc1, _mm256_and_pd(_mm256_loadu_pd(data + i + 4), mask));
+        }
+        double sum = hsumAvx2(_mm256_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += std::fabs(data[i]);
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) double sumSquaresAvx2(double const *data, size_t len) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            __m256d v0 = _mm256_loadu_pd(data + i);
+            __m256d v1 = _mm256_loadu_pd(data + i + 4);
+            acc0 = _mm256_fmadd_pd(v0, v0, acc0);
+            acc1 = _mm256_fmadd_pd(v1, v1, acc1);
+        }
+        double sum = hsumAvx2(_mm256_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += data[i] * data[i];
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) double normInfAvx2(double const *data, size_t len) {
+        __m256d const mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+        __m256d acc = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4)
+            acc = _mm256_max_pd(acc, _mm256_and_pd(_mm256_loadu_pd(data + i), mask));
+        double max = hmaxAvx2(acc);
+        for (; i < len; ++i) {
+            if (std::fabs(data[i]) > max)
+                max = std::fabs(data[i]);
+        }
+        return max;
+    }
+
+    __attribute__((target("avx2,fma"))) double dotAvx2(double const *data1, double const *data2, size_t len) {
+        __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(data1 + i), _mm256_loadu_pd(data2 + i), acc0);
+            acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(data1 + i + 4), _mm256_loadu_pd(data2 + i + 4), acc1);
+        }
+        double sum = hsumAvx2(_mm256_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += data1[i] * data2[i];
+        return sum;
+    }
+
+    /* two rhs rows per pass, so that the 8 accumulators, 2 rhs loads and the lhs load fit the 16 ymm registers */
+    __attribute__((target("avx2,fma"))) void dotBlockAvx2(double const *lhs, double const *rhs, size_t stride, size_t len, double *out) {
+        for (size_t c = 0; c < DOT_BLOCK; c += 2) {
+            double const *rhs0 = rhs + c * stride, *rhs1 = rhs0 + stride;
+            __m256d acc[DOT_BLOCK][2];
+            for (size_t r = 0; r < DOT_BLOCK; ++r)
+                acc[r][0] = acc[r][1] = _mm256_setzero_pd();
+            size_t k = 0;
+            for (; k + 4 <= len; k += 4) {
+                __m256d b0 = _mm256_loadu_pd(rhs0 + k), b1 = _mm256_loadu_pd(rhs1 + k);
+                for (size_t r = 0; r < DOT_BLOCK; ++r) {
+                    __m256d a = _mm256_loadu_pd(lhs + r * stride + k);
+                    acc[r][0] = _mm256_fmadd_pd(a, b0, acc[r][0]);
+                    acc[r][1] = _mm256_fmadd_pd(a, b1, acc[r][1]);
+                }
+            }
+            for (size_t r = 0; r < DOT_BLOCK; ++r) {
+                double sum0 = hsumAvx2(acc[r][0]), sum1 = hsumAvx2(acc[r][1]);
+                for (size_t tail = k; tail < len; ++tail) {
+                    sum0 += lhs[r * stride + tail] * rhs0[tail];
+                    sum1 += lhs[r * stride + tail] * rhs1[tail];
+                }
+                out[r * DOT_BLOCK + c] = sum0;
+                out[r * DOT_BLOCK + c + 1] = sum1;
+            }
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) double distance1Avx2(double const *data1, double const *data2, size_t len, double bound) {
+        __m256d const mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+        double sum = 0;
+        size_t i = 0;
+        while (i + DISTANCE_BLOCK <= len && sum < bound) {
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            for (size_t end = i + DISTANCE_BLOCK; i < end; i += 8) {
+                acc0 = _mm256_add_pd(acc0, _mm256_and_pd(_mm256_sub_pd(_mm256_loadu_pd(data1 + i), _mm256_loadu_pd(data2 + i)), mask));
+                acc1 = _mm256_add_pd(acc1, _mm256_and_pd(_mm256_sub_pd(_mm256_loadu_pd(data1 + i + 4), _mm256_loadu_pd(data2 + i + 4)), mask));
+            }
+            sum += hsumAvx2(_mm256_add_pd(acc0, acc1));
+        }
+        if (i < len && sum < bound)
+            sum += distance1Scalar(data1 + i, data2 + i, len - i, bound - sum);
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) double distance2SquaredAvx2(double const *data1, double const *data2, size_t len, double bound) {
+        double sum = 0;
+        size_t i = 0;
+        while (i + DISTANCE_BLOCK <= len && sum < bound) {
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            for (size_t end = i + DISTANCE_BLOCK; i < end; i += 8) {
+                __m256d diff0 = _mm256_sub_pd(_mm256_loadu_pd(data1 + i), _mm256_loadu_pd(data2 + i));
+                __m256d diff1 = _mm256_sub_pd(_mm256_loadu_pd(data1 + i + 4), _mm256_loadu_pd(data2 + i + 4));
+                acc0 = _mm256_fmadd_pd(diff0, diff0, acc0);
+                acc1 = _mm256_fmadd_pd(diff1, diff1, acc1);
+            }
+            sum += hsumAvx2(_mm256_add_pd(acc0, acc1));
+        }
+        if (i < len && sum < bound)
+            sum += distance2SquaredScalar(data1 + i, data2 + i, len - i, bound - sum);
+        return sum;
+    }
+
+    __attribute__((target("avx2,fma"))) double distanceInfAvx2(double const *data1, double const *data2, size_t len, double bound) {
+        __m256d const mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+        __m256d acc = _mm256_setzero_pd(), unordered = _mm256_setzero_pd();
+        double max = 0;
+        size_t i = 0;
+        while (i + DISTANCE_BLOCK <= len && max < bound) {
+            for (size_t end = i + DISTANCE_BLOCK; i < end; i += 4) {
+                __m256d abs = _mm256_and_pd(_mm256_sub_pd(_mm256_loadu_pd(data1 + i), _mm256_loadu_pd(data2 + i)), mask);
+                acc = _mm256_max_pd(acc, abs);
+                unordered = _mm256_or_pd(unordered, _mm256_cmp_pd(abs, abs, _CMP_UNORD_Q));
+            }
+            if (_mm256_movemask_pd(unordered) != 0)
+                return NAN;
+            max = hmaxAvx2(acc);
+        }
+        if (i < len && max < bound) {
+            double tail = distanceInfScalar(data1 + i, data2 + i, len - i, bound);
+            max = (tail > max || std::isnan(tail)) ? tail : max;
+        }
+        return max;
+    }
+
+    __attribute__((target("avx2,fma"))) void axpyAvx2(double *y, double a, double const *x, size_t len) {
+        __m256d const va = _mm256_set1_pd(a);
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4)
+            _mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        for (; i < len; ++i)
+            y[i] += a * x[i];
+    }
+
+    __attribute__((target("avx2,fma"))) void axpbyAvx2(double *dst, double a, double const *x, double b, double const *y, size_t len) {
+        __m256d const va = _mm256_set1_pd(a);
+        __m256d const vb = _mm256_set1_pd(b);
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4)
+            _mm256_storeu_pd(dst + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_mul_pd(vb, _mm256_loadu_pd(y + i))));
+        for (; i < len; ++i)
+            dst[i] = a * x[i] + b * y[i];
+    }
+
+    __attribute__((target("avx2,fma"))) void scaleAvx2(double *data, double a, size_t len) {
+        __m256d const va = _mm256_set1_pd(a);
+        size_t i = 0;
+        for (; i + 4 <= len; i += 4)
+            _mm256_storeu_pd(data + i, _mm256_mul_pd(va, _mm256_loadu_pd(data + i)));
+        for (; i < len; ++i)
+            data[i] *= a;
+    }
+
+    /* AVX-512F: 8 lanes, two independent accumulators */
+
+    /* The unmasked forms of the intrinsics below fill their unused lanes from a self-initialized variable in
+     * GCC's headers, which trips -Wuninitialized; the all-lanes masked forms compute the same and stay quiet */
+    static const __mmask8 ALL_LANES = 0xFF;
+
+    __attribute__((target("avx512f"))) __m256d lowHalfAvx512(__m512d v) {
+        return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), ALL_LANES, v, 0);
+    }
+
+    __attribute__((target("avx512f"))) __m256d highHalfAvx512(__m512d v) {
+        return _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), ALL_LANES, v, 1);
+    }
+
+    /* folded to 4 lanes and finished by the AVX2 helpers */
+    __attribute__((target("avx512f"))) double hsumAvx512(__m512d v) {
+        return hsumAvx2(_mm256_add_pd(lowHalfAvx512(v), highHalfAvx512(v)));
+    }
+
+    __attribute__((target("avx512f"))) double hmaxAvx512(__m512d v) {
+        return hmaxAvx2(_mm256_max_pd(lowHalfAvx512(v), highHalfAvx512(v)));
+    }
+
+    __attribute__((target("avx512f"))) double norm1Avx512(double const *data, size_t len) {
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            acc0 = _mm512_add_pd(acc0, _mm512_abs_pd(_mm512_loadu_pd(data + i)));
+            acc1 = _mm512_add_pd(acc1, _mm512_abs_pd(_mm512_loadu_pd(data + i + 8)));
+        }
+        double sum = hsumAvx512(_mm512_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += std::fabs(data[i]);
+        return sum;
+    }
+
+    __attribute__((target("avx512f"))) double sumSquaresAvx512(double const *data, size_t len) {
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            __m512d v0 = _mm512_loadu_pd(data + i);
+            __m512d v1 = _mm512_loadu_pd(data + i + 8);
+            acc0 = _mm512_fmadd_pd(v0, v0, acc0);
+            acc1 = _mm512_fmadd_pd(v1, v1, acc1);
+        }
+        double sum = hsumAvx512(_mm512_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += data[i] * data[i];
+        return sum;
+    }
+
+    __attribute__((target("avx512f"))) double normInfAvx512(double const *data, size_t len) {
+        __m512d acc = _mm512_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8)
+            acc = _mm512_mask_max_pd(acc, ALL_LANES, acc, _mm512_abs_pd(_mm512_loadu_pd(data + i)));
+        double max = hmaxAvx512(acc);
+        for (; i < len; ++i) {
+            if (std::fabs(data[i]) > max)
+                max = std::fabs(data[i]);
+        }
+        return max;
+    }
+
+    __attribute__((target("avx512f"))) double dotAvx512(double const *data1, double const *data2, size_t len) {
+        __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(data1 + i), _mm512_loadu_pd(data2 + i), acc0);
+            acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(data1 + i + 8), _mm512_loadu_pd(data2 + i + 8), acc1);
+        }
+        double sum = hsumAvx512(_mm512_add_pd(acc0, acc1));
+        for (; i < len; ++i)
+            sum += data1[i] * data2[i];
+        return sum;
+    }
+
+    /* the full 4 x 4 block at once: 16 accumulators plus the loads fit the 32 zmm registers */
+    __attribute__((target("avx512f"))) void dotBlockAvx512(double const *lhs, double const *rhs, size_t stride, size_t len, double *out) {
+        __m512d acc[DOT_BLOCK][DOT_BLOCK];
+        for (size_t r = 0; r < DOT_BLOCK; ++r) {
+            for (size_t c = 0; c < DOT_BLOCK; ++c)
+                acc[r][c] = _mm512_setzero_pd();
+        }
+        size_t k = 0;
+        for (; k + 8 <= len; k += 8) {
+            __m512d a[DOT_BLOCK];
+            for (size_t r = 0; r < DOT_BLOCK; ++r)
+                a[r] = _mm512_loadu_pd(lhs + r * stride + k);
+            for (size_t c = 0; c < DOT_BLOCK; ++c) {
+                __m512d b = _mm512_loadu_pd(rhs + c * stride + k);
+                for (size_t r = 0; r < DOT_BLOCK; ++r)
+                    acc[r][c] = _mm512_fmadd_pd(a[r], b, acc[r][c]);
+            }
+        }
+        for (size_t r = 0; r < DOT_BLOCK; ++r) {
+            for (size_t c = 0; c < DOT_BLOCK; ++c) {
+                double sum = hsumAvx512(acc[r][c]);
+                for (size_t tail = k; tail < len; ++tail)
+                    sum += lhs[r * stride + tail] * rhs[c * stride + tail];
+                out[r * DOT_BLOCK + c] = sum;
+            }
+        }
+    }
+#endif
+
+    VectorKernels selectKernels() {
+#ifdef VECTOR_KERNELS_X86
+        __builtin_cpu_init();
+        /* the avx512f table borrows the avx2 distance and update kernels, so it needs avx2 and fma as well */
+        bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        if (avx2 && __builtin_cpu_supports("avx512f"))
+            return {norm1Avx512, sumSquaresAvx512, normInfAvx512, dotAvx512,
+                    distance1Avx2, distance2SquaredAvx2, distanceInfAvx2,
+                    axpyAvx2, axpbyAvx2, scaleAvx2, dotBlockAvx512, "avx512f"};
+        if (avx2)
+            return {norm1Avx2, sumSquaresAvx2, normInfAvx2, dotAvx2,
+                    distance1Avx2, distance2SquaredAvx2, distanceInfAvx2,
+                    axpyAvx2, axpbyAvx2, scaleAvx2, dotBlockAvx2, "avx2"};
+        if (__builtin_cpu_supports("sse2"))
+            return {norm1Sse2, sumSquaresSse2, normInfSse2, dotSse2,
+                    distance1Scalar, distance2SquaredScalar, distanceInfScalar,
+                    axpyScalar, axpbyScalar, scaleScalar, dotBlockScalar, "sse2"};
+#endif
+        return {norm1Scalar, sumSquaresScalar, normInfScalar, dotScalar,
+                distance1Scalar, distance2SquaredScalar, distanceInfScalar,
+                axpyScalar, axpbyScalar, scaleScalar, dotBlockScalar, "scalar"};
+    }
+}
+
+VectorKernels const g_vectorKernels = selectKernels();
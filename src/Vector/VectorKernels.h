@@ -0,0 +1,35 @@
+#ifndef VECTORKERNELS_H
+#define VECTORKERNELS_H
+
+#include "../Util/Export.h"
+#include <cstddef> // size_t
+
+/* Reduction kernels over contiguous coordinates, picked once at library load for the running CPU */
+struct VectorKernels {
+    double (*norm1)(double const *data, size_t len);
+    double (*sumSquares)(double const *data, size_t len);
+    double (*normInf)(double const *data, size_t len);
+    double (*dot)(double const *data1, double const *data2, size_t len);
+    /* Distances between two buffers; stop early and return the partial value once it reaches bound */
+    double (*distance1)(double const *data1, double const *data2, size_t len, double bound);
+    double (*distance2Squared)(double const *data1, double const *data2, size_t len, double bound);
+    double (*distanceInf)(double const *data1, double const *data2, size_t len, double bound);
+    /* Element-wise updates; dst may alias any source */
+    void (*axpy)(double *y, double a, double const *x, size_t len);
+    void (*axpby)(double *dst, double a, double const *x, double b, double const *y, size_t len);
+    void (*scale)(double *data, double a, size_t len);
+    /* out[r * DOT_BLOCK + c] = dot of row r of lhs and row c of rhs over len coordinates, for a DOT_BLOCK x DOT_BLOCK
+     * block of rows stride doubles apart, each lhs row loaded once for all the rhs rows */
+    void (*dotBlock)(double const *lhs, double const *rhs, size_t stride, size_t len, double *out);
+    char const *isa;
+};
+
+/* Rows on each side of a dotBlock */
+static const size_t DOT_BLOCK = 4;
+
+/* Coordinates processed between two early-exit checks of the distance kernels */
+static const size_t DISTANCE_BLOCK = 32;
+
+DLL_LOCAL_VISIBILITY extern VectorKernels const g_vectorKernels;
+
+#endif //VECTORKERNELS_H
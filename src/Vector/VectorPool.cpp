@@ -0,0 +1,155 @@
+#include "VectorPool.h"
+#include <new>
+
+thread_local VectorPool::ThreadCache VectorPool::t_cache;
+
+VectorPool &VectorPool::instance() {
+    static VectorPool *pool = new VectorPool();
+    return *pool;
+} //OK
+
+VectorPool::VectorPool() : slots_{0}, hits_{0}, misses_{0}, live_{0}, bytesHeld_{0} {
+    for (size_t slot = 0; slot < MAX_SLOTS; ++slot) {
+        this->dims_[slot].store(0, std::memory_order_relaxed);
+        for (size_t kind = 0; kind < POOL_KINDS; ++kind)
+            this->lists_[slot][kind].size = 0;
+    }
+} //OK
+
+VectorPool::ThreadCache::~ThreadCache() {
+    VectorPool &pool = VectorPool::instance();
+    for (size_t slot = 0; slot < MAX_SLOTS; ++slot) {
+        for (size_t kind = 0; kind < POOL_KINDS; ++kind) {
+            if (this->counts[slot][kind] > 0)
+                pool.flush(slot, static_cast<Kind>(kind), this->sizes[slot][kind], this->blocks[slot][kind], this->counts[slot][kind]);
+            this->counts[slot][kind] = 0;
+        }
+    }
+} //OK
+
+size_t VectorPool::slotOf(size_t dim) const {
+    size_t slots = this->slots_.load(std::memory_order_acquire);
+    if (slots == 0)
+        return MAX_SLOTS;
+    if (dim == 0)
+        return 0;
+    for (size_t slot = 1; slot < slots; ++slot) {
+        if (this->dims_[slot].load(std::memory_order_relaxed) == dim)
+            return slot;
+    }
+    return MAX_SLOTS;
+} //OK
+
+bool VectorPool::enable(size_t dim) {
+    std::lock_guard<std::mutex> lock(this->enableMutex_);
+    if (this->slotOf(dim) < MAX_SLOTS)
+        return true;
+    size_t slots = this->slots_.load(std::memory_order_relaxed);
+    if (slots == 0)
+        slots = 1;
+    if (slots == MAX_SLOTS)
+        return false;
+    this->dims_[slots].store(dim, std::memory_order_relaxed);
+    this->slots_.store(slots + 1, std::memory_order_release);
+    return true;
+} //OK
+
+bool VectorPool::isEnabled(size_t dim) const {
+    return dim != 0 && this->slotOf(dim) < MAX_SLOTS;
+} //OK
+
+void *VectorPool::allocate(size_t dim, Kind kind, size_t size, bool &pooled) {
+    size_t slot = this->slotOf(dim);
+    pooled = slot < MAX_SLOTS;
+    if (!pooled)
+        return ::operator new(size, std::nothrow);
+
+    ThreadCache &cache = t_cache;
+    size_t &count = cache.counts[slot][kind];
+    if (count == 0) {
+        FreeList &list = this->lists_[slot][kind];
+        std::lock_guard<std::mutex> lock(list.mutex);
+        while (count < CACHE_SIZE / 2 && !list.blocks.empty()) {
+            cache.blocks[slot][kind][count++] = list.blocks.back();
+            list.blocks.pop_back();
+        }
+    }
+
+    void *memory = nullptr;
+    if (count > 0) {
+        memory = cache.blocks[slot][kind][--count];
+        this->hits_.fetch_add(1, std::memory_order_relaxed);
+        this->bytesHeld_.fetch_sub(size, std::memory_order_relaxed);
+    } else {
+        memory = ::operator new(size, std::nothrow);
+        if (memory == nullptr) {
+            pooled = false;
+            return nullptr;
+        }
+        this->misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    this->live_.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+} //OK
+
+void VectorPool::release(void *memory, size_t dim, Kind kind, size_t size) {
+    size_t slot = this->slotOf(dim);
+    ThreadCache &cache = t_cache;
+    size_t &count = cache.counts[slot][kind];
+    if (count == CACHE_SIZE) {
+        this->flush(slot, kind, size, cache.blocks[slot][kind] + CACHE_SIZE / 2, CACHE_SIZE / 2);
+        count = CACHE_SIZE / 2;
+    }
+    cache.blocks[slot][kind][count++] = memory;
+    cache.sizes[slot][kind] = size;
+    this->live_.fetch_sub(1, std::memory_order_relaxed);
+    this->bytesHeld_.fetch_add(size, std::memory_order_relaxed);
+} //OK
+
+void VectorPool::flush(size_t slot, Kind kind, size_t size, void **cached, size_t count) {
+    FreeList &list = this->lists_[slot][kind];
+    std::lock_guard<std::mutex> lock(list.mutex);
+    list.size = size;
+    list.blocks.insert(list.blocks.end(), cached, cached + count);
+} //OK
+
+void VectorPool::trim() {
+    ThreadCache &cache = t_cache;
+    for (size_t slot = 0; slot < MAX_SLOTS; ++slot) {
+        for (size_t kind = 0; kind < POOL_KINDS; ++kind) {
+            size_t &count = cache.counts[slot][kind];
+            for (size_t i = 0; i < count; ++i)
+                ::operator delete(cache.blocks[slot][kind][i]);
+            this->bytesHeld_.fetch_sub(count * cache.sizes[slot][kind], std::memory_order_relaxed);
+            count = 0;
+
+            FreeList &list = this->lists_[slot][kind];
+            std::vector<void *> blocks;
+            size_t size;
+            {
+                std::lock_guard<std::mutex> lock(list.mutex);
+                blocks.swap(list.blocks);
+                size = list.size;
+            }
+            for (std::vector<void *>::iterator it = blocks.begin(); it < blocks.end(); ++it)
+                ::operator delete(*it);
+            this->bytesHeld_.fetch_sub(blocks.size() * size, std::memory_order_relaxed);
+        }
+    }
+} //OK
+
+size_t VectorPool::getHits() const {
+    return this->hits_.load(std::memory_order_relaxed);
+} //OK
+
+size_t VectorPool::getMisses() const {
+    return this->misses_.load(std::memory_order_relaxed);
+} //OK
+
+size_t VectorPool::getLive() const {
+    return this->live_.load(std::memory_order_relaxed);
+} //OK
+
+size_t VectorPool::getBytesHeld() const {
+    return this->bytesHeld_.load(std::memory_order_relaxed);
+} //OK
@@ -0,0 +1,81 @@
+#ifndef VECTORPOOL_H
+#define VECTORPOOL_H
+
+#include "../Util/Export.h"
+#include <atomic>
+#include <cstddef> // size_t
+#include <mutex>
+#include <vector>
+
+/* Free lists of heap vector storage keyed by dimension and kind, behind a small cache per thread.
+ * Memory taken from it may be released on any thread. It is never destroyed, so it stays usable while
+ * other static objects and threads are torn down at exit. */
+class DLL_LOCAL_VISIBILITY VectorPool {
+    public:
+        enum Kind {
+            POOL_BLOCK,
+            POOL_BUFFER,
+            POOL_KINDS
+        };
+
+        /* dimensions a pool serves, besides the header-only blocks of dimension 0 */
+        static const size_t MAX_DIMS = 15;
+        /* blocks a thread keeps per dimension and kind before handing half of them to the shared list */
+        static const size_t CACHE_SIZE = 32;
+
+        static VectorPool& instance();
+
+        /* false when MAX_DIMS dimensions are already enabled */
+        bool enable(size_t dim);
+        bool isEnabled(size_t dim) const;
+        /* size bytes, recycled when dim is enabled, in which case pooled is set and the memory must go back
+         * through release with the same dim, kind and size */
+        void* allocate(size_t dim, Kind kind, size_t size, bool& pooled);
+        void release(void* memory, size_t dim, Kind kind, size_t size);
+        /* frees the shared lists and the cache of the calling thread */
+        void trim();
+
+        size_t getHits() const;
+        size_t getMisses() const;
+        size_t getLive() const;
+        size_t getBytesHeld() const;
+
+    private:
+        static const size_t MAX_SLOTS = MAX_DIMS + 1;
+
+        struct FreeList {
+            std::mutex mutex;
+            std::vector<void*> blocks;
+            size_t size;
+        };
+
+        /* per-thread front of the free lists, flushed to them when the thread ends */
+        struct ThreadCache {
+            void* blocks[MAX_SLOTS][POOL_KINDS][CACHE_SIZE];
+            size_t counts[MAX_SLOTS][POOL_KINDS];
+            size_t sizes[MAX_SLOTS][POOL_KINDS];
+            ~ThreadCache();
+        };
+
+        VectorPool();
+        VectorPool(VectorPool const&)            = delete;
+        VectorPool& operator=(VectorPool const&) = delete;
+
+        /* index of dim in dims_, or MAX_SLOTS when it is not enabled; dimension 0 takes slot 0 once anything is */
+        size_t slotOf(size_t dim) const;
+        /* moves count blocks of size bytes from the end of cached into the shared list of slot and kind */
+        void flush(size_t slot, Kind kind, size_t size, void** cached, size_t count);
+
+        static thread_local ThreadCache t_cache;
+
+        std::mutex enableMutex_;
+        std::atomic<size_t> dims_[MAX_SLOTS];
+        std::atomic<size_t> slots_;
+        FreeList lists_[MAX_SLOTS][POOL_KINDS];
+        std::atomic<size_t> hits_;
+        std::atomic<size_t> misses_;
+        std::atomic<size_t> live_;
+        std::atomic<size_t> bytesHeld_;
+};
+
+#endif //VECTORPOOL_H
@@ -0,0 +1,166 @@
+#include "IVector.h"
+#include "ParallelKernels.h"
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#define MSG_DEFAULT __FUNCTION__
+#define VECLOG(logger, msg, rc) VECLOG_SEV(logger, msg, rc, ILogger::Severity::SEV_ERROR)
+#define VECLOG_SEV(logger, msg, rc, severity)\
+if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr) {\
+    logger->log(msg, rc, severity);\
+}
+
+namespace {
+    class VectorViewImpl : public IVector {
+        public:
+            IVector *clone() const override;
+            ReturnCode setCoord(size_t index, double value) const override;
+            double getCoord(size_t index) const override;
+            double norm(Norm norm) const override;
+            size_t getDim() const override;
+            double const *getData() const override;
+            double *getData() override;
+            ReturnCode getCoords(size_t begin, size_t count, double *dst) const override;
+            ReturnCode setCoords(size_t begin, size_t count, double const *src) const override;
+
+            VectorViewImpl(size_t dim, double *data, size_t stride);
+            ~VectorViewImpl();
+
+        private:
+            size_t dim_;
+            double *data_;
+            size_t stride_;
+            ILogger *logger_;
+    };
+}
+
+VectorViewImpl::VectorViewImpl(size_t dim, double *data, size_t stride) : dim_{dim}, data_{data}, stride_{stride} {
+    this->logger_ = ILogger::createLogger(this);
+} //OK
+
+VectorViewImpl::~VectorViewImpl() {
+    this->data_ = nullptr;
+    if (this->logger_ != nullptr)
+        this->logger_->releaseLogger(this);
+} //OK
+
+IVector *VectorViewImpl::clone() const {
+    return IVector::clone(nullptr, this, this->logger_);
+} //OK
+
+ReturnCode VectorViewImpl::setCoord(size_t index, double value) const {
+    if (index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    if (std::isnan(value)) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+        return ReturnCode::RC_NAN;
+    }
+    this->data_[index * this->stride_] = value;
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+double VectorViewImpl::getCoord(size_t index) const {
+    if (index >= this->dim_) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return NAN;
+    }
+    return this->data_[index * this->stride_];
+} //OK
+
+double VectorViewImpl::norm(IVector::Norm norm) const {
+    if (this->stride_ == 1) {
+        switch (norm) {
+            case IVector::Norm::NORM_1:
+                return kernelsFor(this->dim_).norm1(this->data_, this->dim_);
+            case IVector::Norm::NORM_2:
+                return std::sqrt(kernelsFor(this->dim_).sumSquares(this->data_, this->dim_));
+            case IVector::Norm::NORM_INF:
+                return kernelsFor(this->dim_).normInf(this->data_, this->dim_);
+            default:
+                VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+                return std::nan("1");
+        }
+    }
+
+    double vec_norm = 0;
+    double const *coord = this->data_;
+    switch (norm) {
+        case IVector::Norm::NORM_1:
+            for (size_t i = 0; i < this->dim_; ++i, coord += this->stride_)
+                vec_norm += std::fabs(*coord);
+            break;
+        case IVector::Norm::NORM_2:
+            for (size_t i = 0; i < this->dim_; ++i, coord += this->stride_)
+                vec_norm += *coord * *coord;
+            vec_norm = std::sqrt(vec_norm);
+            break;
+        case IVector::Norm::NORM_INF:
+            for (size_t i = 0; i < this->dim_; ++i, coord += this->stride_)
+                vec_norm = std::fabs(*coord) > vec_norm || std::isnan(*coord) ? std::fabs(*coord) : vec_norm;
+            break;
+        default:
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_INVALID_PARAMS);
+            vec_norm = std::nan("1");
+            break;
+    }
+    return vec_norm;
+} //OK
+
+size_t VectorViewImpl::getDim() const {
+    return this->dim_;
+} //OK
+
+double const *VectorViewImpl::getData() const {
+    return this->stride_ == 1 ? this->data_ : nullptr;
+} //OK
+
+double *VectorViewImpl::getData() {
+    return this->stride_ == 1 ? this->data_ : nullptr;
+} //OK
+
+ReturnCode VectorViewImpl::getCoords(size_t begin, size_t count, double *dst) const {
+    if (dst == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    if (this->stride_ == 1) {
+        std::memcpy(dst, this->data_ + begin, count * sizeof(double));
+        return ReturnCode::RC_SUCCESS;
+    }
+    double const *coord = this->data_ + begin * this->stride_;
+    for (size_t i = 0; i < count; ++i, coord += this->stride_)
+        dst[i] = *coord;
+    return ReturnCode::RC_SUCCESS;
+} //OK
+
+ReturnCode VectorViewImpl::setCoords(size_t begin, size_t count, double const *src) const {
+    if (src == nullptr) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    if (begin > this->dim_ || count > this->dim_ - begin) {
+        VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_OUT_OF_BOUNDS);
+        return ReturnCode::RC_OUT_OF_BOUNDS;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (std::isnan(src[i])) {
+            VECLOG(this->logger_, MSG_DEFAULT, ReturnCode::RC_NAN);
+            return ReturnCode::RC_NAN;
+        }
+    }
+    if (this->stride_ == 1) {
+        std::memmove(this->data_ + begin, src, count * sizeof(double));
+        return ReturnCode::RC_SUCCESS;
+    }
+    double *coord = this->data_ + begin * this->stride_;
+    for (size_t i = 0; i < count; ++i, coord += this->stride_)
+        *coord = src[i];
+    return ReturnCode::RC_SUCCESS;
+} //OK
@@ -0,0 +1,199 @@
+#ifndef FIXEDVECTOR_H
+#define FIXEDVECTOR_H
+
+#include "IVector.h"
+#include <cmath>
+#include <cstring>
+#include <new>
+
+namespace fixed_vector_detail {
+    /* element-wise loops over the first I coordinates, unrolled at compile time */
+    template <size_t I>
+    struct Unroll {
+        static void add(double *dst, double const *a, double const *b) {
+            Unroll<I - 1>::add(dst, a, b);
+            dst[I - 1] = a[I - 1] + b[I - 1];
+        }
+        static void sub(double *dst, double const *a, double const *b) {
+            Unroll<I - 1>::sub(dst, a, b);
+            dst[I - 1] = a[I - 1] - b[I - 1];
+        }
+        static void scale(double *dst, double const *a, double s) {
+            Unroll<I - 1>::scale(dst, a, s);
+            dst[I - 1] = a[I - 1] * s;
+        }
+        static double dot(double const *a, double const *b) {
+            return Unroll<I - 1>::dot(a, b) + a[I - 1] * b[I - 1];
+        }
+        static double sumAbs(double const *a) {
+            return Unroll<I - 1>::sumAbs(a) + std::fabs(a[I - 1]);
+        }
+        static double maxAbs(double const *a) {
+            double prev = Unroll<I - 1>::maxAbs(a);
+            double cur = std::fabs(a[I - 1]);
+            return cur > prev ? cur : prev;
+        }
+    };
+
+    template <>
+    struct Unroll<0> {
+        static void add(double *, double const *, double const *) {}
+        static void sub(double *, double const *, double const *) {}
+        static void scale(double *, double const *, double) {}
+        static double dot(double const *, double const *) { return 0; }
+        static double sumAbs(double const *) { return 0; }
+        static double maxAbs(double const *) { return 0; }
+    };
+}
+
+/* Header-only IVector of compile-time dimension N with inline storage, meant for small N (2D, 3D points).
+ * It is copyable, unlike other vectors, and works anywhere an IVector is accepted. The static
+ * add/sub/mul below take FixedVector<N> operands and run unrolled loops without virtual dispatch.
+ * The logger is borrowed: it is not registered and must outlive the vector. */
+template <size_t N>
+class FixedVector final : public IVector {
+    static_assert(N > 0, "FixedVector needs at least one coordinate");
+
+    public:
+        static const size_t DIM = N;
+
+        using IVector::add;
+        using IVector::sub;
+        using IVector::mul;
+
+        static FixedVector add(FixedVector const& addend1, FixedVector const& addend2) {
+            FixedVector sum;
+            fixed_vector_detail::Unroll<N>::add(sum.coords_, addend1.coords_, addend2.coords_);
+            return sum;
+        }
+        static FixedVector sub(FixedVector const& minuend, FixedVector const& subtrahend) {
+            FixedVector diff;
+            fixed_vector_detail::Unroll<N>::sub(diff.coords_, minuend.coords_, subtrahend.coords_);
+            return diff;
+        }
+        /* a NaN scale yields a NaN-filled vector instead of an error; check it upstream */
+        static FixedVector mul(FixedVector const& multiplier, double scale) {
+            FixedVector prod;
+            fixed_vector_detail::Unroll<N>::scale(prod.coords_, multiplier.coords_, scale);
+            return prod;
+        }
+        static double mul(FixedVector const& multiplier1, FixedVector const& multiplier2) {
+            return fixed_vector_detail::Unroll<N>::dot(multiplier1.coords_, multiplier2.coords_);
+        }
+
+        /* zero vector */
+        explicit FixedVector(ILogger* logger = nullptr) : IVector(), coords_(), logger_{logger} {}
+        /* coordinates are taken as given and not scanned for NaN */
+        explicit FixedVector(double const (&coords)[N], ILogger* logger = nullptr) : IVector(), logger_{logger} {
+            std::memcpy(this->coords_, coords, sizeof(this->coords_));
+        }
+        FixedVector(FixedVector const& other) : IVector(), logger_{other.logger_} {
+            std::memcpy(this->coords_, other.coords_, sizeof(this->coords_));
+        }
+        FixedVector& operator=(FixedVector const& other) {
+            std::memcpy(this->coords_, other.coords_, sizeof(this->coords_));
+            this->logger_ = other.logger_;
+            return *this;
+        }
+        ~FixedVector() {}
+
+        IVector* clone() const override {
+            IVector* cloned = new(std::nothrow)FixedVector(*this);
+            if (cloned == nullptr)
+                this->log(__FUNCTION__, ReturnCode::RC_NO_MEM);
+            return cloned;
+        }
+
+        ReturnCode setCoord(size_t index, double value) const override {
+            if (index >= N) {
+                this->log(__FUNCTION__, ReturnCode::RC_OUT_OF_BOUNDS);
+                return ReturnCode::RC_OUT_OF_BOUNDS;
+            }
+            if (std::isnan(value)) {
+                this->log(__FUNCTION__, ReturnCode::RC_NAN);
+                return ReturnCode::RC_NAN;
+            }
+            this->coords_[index] = value;
+            return ReturnCode::RC_SUCCESS;
+        }
+
+        double getCoord(size_t index) const override {
+            if (index >= N) {
+                this->log(__FUNCTION__, ReturnCode::RC_OUT_OF_BOUNDS);
+                return NAN;
+            }
+            return this->coords_[index];
+        }
+
+        double norm(Norm norm) const override {
+            switch (norm) {
+                case Norm::NORM_1:
+                    return fixed_vector_detail::Unroll<N>::sumAbs(this->coords_);
+                case Norm::NORM_2:
+                    return std::sqrt(fixed_vector_detail::Unroll<N>::dot(this->coords_, this->coords_));
+                case Norm::NORM_INF:
+                    return fixed_vector_detail::Unroll<N>::maxAbs(this->coords_);
+                default:
+                    this->log(__FUNCTION__, ReturnCode::RC_INVALID_PARAMS);
+                    return std::nan("1");
+            }
+        }
+
+        size_t getDim() const override {
+            return N;
+        }
+
+        double const* getData() const override {
+            return this->coords_;
+        }
+
+        double* getData() override {
+            return this->coords_;
+        }
+
+        ReturnCode getCoords(size_t begin, size_t count, double* dst) const override {
+            if (dst == nullptr) {
+                this->log(__FUNCTION__, ReturnCode::RC_NULL_PTR);
+                return ReturnCode::RC_NULL_PTR;
+            }
+            if (begin > N || count > N - begin) {
+                this->log(__FUNCTION__, ReturnCode::RC_OUT_OF_BOUNDS);
+                return ReturnCode::RC_OUT_OF_BOUNDS;
+            }
+            std::memcpy(dst, this->coords_ + begin, count * sizeof(double));
+            return ReturnCode::RC_SUCCESS;
+        }
+
+        ReturnCode setCoords(size_t begin, size_t count, double const* src) const override {
+            if (src == nullptr) {
+                this->log(__FUNCTION__, ReturnCode::RC_NULL_PTR);
+                return ReturnCode::RC_NULL_PTR;
+            }
+            if (begin > N || count > N - begin) {
+                this->log(__FUNCTION__, ReturnCode::RC_OUT_OF_BOUNDS);
+                return ReturnCode::RC_OUT_OF_BOUNDS;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                if (std::isnan(src[i])) {
+                    this->log(__FUNCTION__, ReturnCode::RC_NAN);
+                    return ReturnCode::RC_NAN;
+                }
+            }
+            std::memmove(this->coords_ + begin, src, count * sizeof(double));
+            return ReturnCode::RC_SUCCESS;
+        }
+
+    private:
+        void log(char const* msg, ReturnCode rc) const {
+            if (this->logger_ != nullptr)
+                this->logger_->log(msg, rc);
+        }
+
+        mutable double coords_[N];
+        ILogger* logger_;
+};
+
+template <size_t N>
+const size_t FixedVector<N>::DIM;
+
+#endif //FIXEDVECTOR_H
@@ -0,0 +1,38 @@
+#ifndef IVECTORPOOL_H
+#define IVECTORPOOL_H
+
+#include "../../Logger/include/ILogger.h"
+#include "../../Util/ReturnCode.h"
+#include "../../Util/Export.h"
+#include <cstddef> // size_t
+
+/* Process-wide recycling of heap vectors of a few chosen dimensions. Once a dimension is enabled, the storage of
+ * a deleted dense heap vector of that dimension, however it was made (createVector, clone, add, sub, getPoint...),
+ * is kept for the next one instead of going back to the system. Vectors may be deleted on any thread at any time:
+ * each thread keeps a small cache in front of shared free lists. Arena, float and sparse vectors are not pooled. */
+class DECLSPEC IVectorPool {
+    public:
+        struct Stats {
+            /* allocations served from the pool, and those that had to go to the system */
+            size_t hits;
+            size_t misses;
+            double hitRate;
+            /* pooled blocks currently in use */
+            size_t live;
+            /* bytes kept in free lists */
+            size_t bytesHeld;
+        };
+
+        /* at most 15 dimensions can be enabled, and they stay enabled */
+        static ReturnCode enable(size_t dim, ILogger* logger = nullptr);
+        static bool isEnabled(size_t dim);
+        static Stats getStats();
+        /* frees the shared free lists and the calling thread's cache; other threads hand their caches
+         * to the shared lists when they end */
+        static void trim();
+
+    private:
+        IVectorPool() = delete;
+};
+
+#endif //IVECTORPOOL_H
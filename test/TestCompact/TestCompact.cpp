@@ -53,6 +53,8 @@ int main() {
     tests.push_back(convex_WrongDim_NullPtr);
     tests.push_back(intersection_NullPtr_NullPtr);
     tests.push_back(intersection_WrongDim_NullPtr);
+    tests.push_back(doStep_DebugBelowThreshold_NotLogged);
+    tests.push_back(doStep_DebugThreshold_Logged);
 
     int testCounter = 0;
     int passedTestConter = 0;
@@ -4,6 +4,7 @@
 #include <new>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 
 #include "../include/ILogger.h"
@@ -1127,5 +1128,76 @@ bool intersection_WrongDim_NullPtr(ILogger *logger, char *& testName) {
 //    testName = const_cast<char *>(__FUNCTION__); return false;
 //}
 
+/* lines of a log file holding text */
+static size_t countLines(char const *fileName, char const *text) {
+    FILE *file = fopen(fileName, "r");
+    if (file == nullptr)
+        return 0;
+    size_t count = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (strstr(line, text) != nullptr)
+            count++;
+    }
+    fclose(file);
+    return count;
+}
+
+/* steps a 1-dimensional compact from begin to end, where doStep logs its SEV_DEBUG record */
+static void iterateToEnd(ILogger *logger) {
+    double *beginData = new(std::nothrow) double[g_dim1];
+    assert(beginData != nullptr);
+    std::memcpy(beginData, g_data1FarLeft, g_dim1 * sizeof(double));
+    IVector *begin = IVector::createVector(g_dim1, beginData, logger);
+    assert(begin != nullptr);
+
+    double *endData = new(std::nothrow) double[g_dim1];
+    assert(endData != nullptr);
+    std::memcpy(endData, g_data1Right, g_dim1 * sizeof(double));
+    IVector *end = IVector::createVector(g_dim1, endData, logger);
+    assert(end != nullptr);
+
+    double *stepData = new(std::nothrow) double[g_dim1]{2.5};
+    assert(stepData != nullptr);
+    IVector *step = IVector::createVector(g_dim1, stepData, logger);
+    assert(step != nullptr);
+
+    ICompact *comp = ICompact::createCompact(begin, end, EPS, logger);
+    assert(comp != nullptr);
+    ICompact::Iterator *it = comp->begin(step);
+    assert(it != nullptr);
+    while (it->doStep() == ReturnCode::RC_SUCCESS) {
+    }
+
+    delete it;
+    delete comp;
+    delete step;
+    delete begin;
+    delete end;
+}
+
+bool doStep_DebugBelowThreshold_NotLogged(ILogger *logger, char *& testName) {
+    logger->setLogFile("TestCompactThreshold.log");
+    ILogger::Severity previous = ILogger::getThreshold();
+    ILogger::setThreshold(ILogger::Severity::SEV_INFO);
+    iterateToEnd(logger);
+    logger->flush();
+    ILogger::setThreshold(previous);
+
+    bool passed = countLines("TestCompactThreshold.log", "--Function:[doStep]") == 0;
+    testName = const_cast<char *>(__FUNCTION__); return passed;
+}
+
+bool doStep_DebugThreshold_Logged(ILogger *logger, char *& testName) {
+    logger->setLogFile("TestCompactThresholdDebug.log");
+    ILogger::Severity previous = ILogger::getThreshold();
+    ILogger::setThreshold(ILogger::Severity::SEV_DEBUG);
+    iterateToEnd(logger);
+    logger->flush();
+    ILogger::setThreshold(previous);
+
+    bool passed = countLines("TestCompactThresholdDebug.log", "--Function:[doStep]") == 1;
+    testName = const_cast<char *>(__FUNCTION__); return passed;
+}
 
 #endif //TESTCOMPACT_H
@@ -0,0 +1,56 @@
+#include "TestLogger.h"
+#include "../include/Tester.h"
+#include <vector>
+
+int main() {
+    void *client = (void *) new(std::nothrow) int;
+    assert(client != nullptr);
+    ILogger *logger = ILogger::createLogger(client);
+    assert(logger != nullptr);
+    logger->setLogFile("TestLogger.log");
+
+    std::cout << "\nILogger Testing...\n" << '\n';
+    int i = 0;
+    std::cout << std::setw(gaps[i++]) << "" << " :: ";
+
+    for (int j = 0; j < 3; ++j) {
+        std::cout << std::setw(gaps[j + i]) << columnNames[j] << " ";
+    }
+    std::cout << "\n\n";
+
+    std::vector<Test_t> tests;
+    tests.push_back(log_RateLimitDefault_AllWritten);
+    tests.push_back(setAsync_Flush_OrderedAndComplete);
+    tests.push_back(setAsync_DropTinyCapacity_DroppedLine);
+    tests.push_back(setAsync_OverwriteTinyCapacity_NewestKept);
+    tests.push_back(setAsync_Disable_QueueDrained);
+    tests.push_back(setLogFile_ConcurrentLog_WholeLines);
+    tests.push_back(setThreshold_BelowThreshold_NotWritten);
+    tests.push_back(setThreshold_Debug_DebugWritten);
+    tests.push_back(LogCodec_Records_RoundTrip);
+    tests.push_back(LogCodec_CollidingSites_NamesKept);
+    tests.push_back(LogCodec_LongName_Truncated);
+    tests.push_back(LogCodec_NegativeDeltas_RoundTrip);
+    tests.push_back(LogCodec_DroppedAndRepeated_RoundTrip);
+    tests.push_back(LogDecoder_TruncatedInput_InvalidParams);
+    tests.push_back(LogDecoder_CorruptInput_InvalidParams);
+    tests.push_back(setLogFile_Binary_EpochTimestamps);
+    tests.push_back(setRateLimit_Burst_RestCountedOnFlush);
+    tests.push_back(setRateLimit_PeriodElapsed_SummaryBeforeRecord);
+    tests.push_back(setRateLimit_SlotTaken_EvictedSummary);
+    tests.push_back(setRateLimit_ThreadExit_Summary);
+
+    int testCounter = 0;
+    int passedTestConter = 0;
+    for (int j = 0, testsLen = tests.size(); j < testsLen; ++j) {
+        if (passTest(tests[j], "ILogger", testCounter, logger))
+            passedTestConter++;
+    }
+
+    std::cout << "\nPASSED: " << passedTestConter << "/" << testCounter << ".\n";
+
+    logger->releaseLogger(client);
+    delete (int*)client;
+
+    return 0;
+}
@@ -0,0 +1,549 @@
+#ifndef TESTLOGGER_H
+#define TESTLOGGER_H
+
+#include <new>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/ILogger.h"
+#include "../../src/Logger/LogCodec.h"
+
+static const size_t g_records = 1000;
+/* the epoch the codec tests write in the header */
+static const int64_t g_epoch = 1700000000000000LL;
+
+/* lines of a log file, without their newlines */
+static std::vector<std::string> readLines(char const *fileName) {
+    std::vector<std::string> lines;
+    FILE *file = fopen(fileName, "r");
+    if (file == nullptr)
+        return lines;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        size_t length = strlen(line);
+        if (length > 0 && line[length - 1] == '\n')
+            line[length - 1] = '\0';
+        lines.push_back(line);
+    }
+    fclose(file);
+    return lines;
+}
+
+/* the function name of a record line, empty for other lines */
+static std::string functionOf(std::string const &line) {
+    size_t begin = line.find("--Function:[");
+    if (begin == std::string::npos)
+        return "";
+    begin += strlen("--Function:[");
+    return line.substr(begin, line.find(']', begin) - begin);
+}
+
+/* the count of a "--Dropped:[n] records" line, 0 for other lines */
+static size_t droppedOf(std::string const &line) {
+    if (line.compare(0, strlen("--Dropped:["), "--Dropped:[") != 0)
+        return 0;
+    return strtoul(line.c_str() + strlen("--Dropped:["), nullptr, 10);
+}
+
+/* the count of a summary line's "--Repeated:[n]", 0 for other lines */
+static size_t repeatedOf(std::string const &line) {
+    size_t begin = line.find("--Repeated:[");
+    if (begin == std::string::npos)
+        return 0;
+    return strtoul(line.c_str() + begin + strlen("--Repeated:["), nullptr, 10);
+}
+
+/* logs g_records records named record0..record999 */
+static void logRecords(ILogger *logger) {
+    char name[32];
+    for (size_t i = 0; i < g_records; ++i) {
+        snprintf(name, sizeof(name), "record%zu", i);
+        logger->log(name, ReturnCode::RC_NAN);
+    }
+}
+
+bool setAsync_Flush_OrderedAndComplete(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerAsync.log");
+    bool passed = logger->setAsync(true, 64, ILogger::Overflow::OVERFLOW_BLOCK) == ReturnCode::RC_SUCCESS;
+    logRecords(logger);
+    logger->flush();
+
+    std::vector<std::string> lines = readLines("TestLoggerAsync.log");
+    passed = passed && lines.size() == g_records;
+    long previous = 0;
+    for (size_t i = 0; passed && i < lines.size(); ++i) {
+        long counter = strtol(lines[i].c_str(), nullptr, 10);
+        passed = functionOf(lines[i]) == "record" + std::to_string(i) && counter > previous;
+        previous = counter;
+    }
+    logger->setAsync(false);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+/* records written plus records reported dropped in fileName, and whether the last record logged is among them */
+static size_t countAccounted(char const *fileName, size_t &dropped, bool &lastWritten) {
+    std::vector<std::string> lines = readLines(fileName);
+    size_t written = 0;
+    dropped = 0;
+    lastWritten = false;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        std::string function = functionOf(lines[i]);
+        if (!function.empty())
+            written++;
+        if (function == "record" + std::to_string(g_records - 1))
+            lastWritten = true;
+        dropped += droppedOf(lines[i]);
+    }
+    return written + dropped;
+}
+
+bool setAsync_DropTinyCapacity_DroppedLine(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerDrop.log");
+    bool passed = logger->setAsync(true, 2, ILogger::Overflow::OVERFLOW_DROP) == ReturnCode::RC_SUCCESS;
+    logRecords(logger);
+    logger->flush();
+
+    size_t dropped;
+    bool lastWritten;
+    passed = passed && countAccounted("TestLoggerDrop.log", dropped, lastWritten) == g_records && dropped > 0;
+    logger->setAsync(false);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setAsync_OverwriteTinyCapacity_NewestKept(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerOverwrite.log");
+    bool passed = logger->setAsync(true, 2, ILogger::Overflow::OVERFLOW_OVERWRITE) == ReturnCode::RC_SUCCESS;
+    logRecords(logger);
+    logger->flush();
+
+    size_t dropped;
+    bool lastWritten;
+    passed = passed && countAccounted("TestLoggerOverwrite.log", dropped, lastWritten) == g_records && dropped > 0 && lastWritten;
+    logger->setAsync(false);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setAsync_Disable_QueueDrained(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerDrain.log");
+    bool passed = logger->setAsync(true, 2 * g_records, ILogger::Overflow::OVERFLOW_BLOCK) == ReturnCode::RC_SUCCESS;
+    logRecords(logger);
+    /* no flush: switching back to synchronous mode has to write out what is queued */
+    passed = passed && logger->setAsync(false) == ReturnCode::RC_SUCCESS;
+    logger->flush();
+
+    std::vector<std::string> lines = readLines("TestLoggerDrain.log");
+    passed = passed && lines.size() == g_records && functionOf(lines.back()) == "record" + std::to_string(g_records - 1);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setLogFile_ConcurrentLog_WholeLines(ILogger *logger, char *&testName) {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i)
+        threads.push_back(std::thread(logRecords, logger));
+    /* the file and its format change under the synchronous writers */
+    for (size_t i = 0; i < 50; ++i)
+        logger->setLogFile(i % 2 == 0 ? "TestLoggerSwitchText.log" : "TestLoggerSwitchBinary.log",
+                           i % 2 == 0 ? ILogger::Format::FORMAT_TEXT : ILogger::Format::FORMAT_BINARY);
+    logger->setLogFile("TestLoggerSwitchText.log");
+    logRecords(logger);
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+    logger->flush();
+
+    std::vector<std::string> lines = readLines("TestLoggerSwitchText.log");
+    bool passed = lines.size() >= g_records;
+    for (size_t i = 0; passed && i < lines.size(); ++i)
+        passed = functionOf(lines[i]).compare(0, strlen("record"), "record") == 0 && lines[i].back() == ']';
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setThreshold_BelowThreshold_NotWritten(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerThreshold.log");
+    ILogger::Severity previous = ILogger::getThreshold();
+    ILogger::setThreshold(ILogger::Severity::SEV_INFO);
+    logger->log("debugRecord", ReturnCode::RC_NAN, ILogger::Severity::SEV_DEBUG);
+    logger->log("infoRecord", ReturnCode::RC_NAN, ILogger::Severity::SEV_INFO);
+    ILogger::setThreshold(ILogger::Severity::SEV_WARNING);
+    logger->log("infoRecord", ReturnCode::RC_NAN, ILogger::Severity::SEV_INFO);
+    logger->log("warningRecord", ReturnCode::RC_NAN, ILogger::Severity::SEV_WARNING);
+    logger->flush();
+    ILogger::setThreshold(previous);
+
+    std::vector<std::string> lines = readLines("TestLoggerThreshold.log");
+    bool passed = lines.size() == 2 && functionOf(lines[0]) == "infoRecord" && functionOf(lines[1]) == "warningRecord";
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setThreshold_Debug_DebugWritten(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerThresholdDebug.log");
+    ILogger::Severity previous = ILogger::getThreshold();
+    ILogger::setThreshold(ILogger::Severity::SEV_DEBUG);
+    logger->log("debugRecord", ReturnCode::RC_NAN, ILogger::Severity::SEV_DEBUG);
+    logger->flush();
+    ILogger::setThreshold(previous);
+
+    std::vector<std::string> lines = readLines("TestLoggerThresholdDebug.log");
+    bool passed = lines.size() == 1 && functionOf(lines[0]) == "debugRecord";
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+static LogRecord makeRecord(char const *function, ReturnCode rc, int severity, int64_t timestamp, size_t counter) {
+    LogRecord record;
+    strncpy(record.function, function, LogRecord::FUNCTION_SIZE - 1);
+    record.function[LogRecord::FUNCTION_SIZE - 1] = '\0';
+    record.rc = rc;
+    record.severity = severity;
+    record.timestamp = timestamp;
+    record.counter = counter;
+    record.repeated = 0;
+    record.span = 0;
+    return record;
+}
+
+static bool sameRecord(LogRecord const &lhs, LogRecord const &rhs) {
+    return strcmp(lhs.function, rhs.function) == 0 && lhs.rc == rhs.rc && lhs.severity == rhs.severity &&
+           lhs.timestamp == rhs.timestamp && lhs.counter == rhs.counter && lhs.repeated == rhs.repeated && lhs.span == rhs.span;
+}
+
+/* encodes records into fileName; a record with repeated set goes in as a summary, one named "" as a dropped entry of counter */
+static void encodeRecords(char const *fileName, std::vector<LogRecord> const &records) {
+    LogEncoder *encoder = new(std::nothrow) LogEncoder();
+    assert(encoder != nullptr);
+    FILE *file = fopen(fileName, "wb");
+    assert(file != nullptr);
+    encoder->reset(file, g_epoch);
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].function[0] == '\0')
+            encoder->addDropped(records[i].counter);
+        else if (records[i].repeated > 0)
+            encoder->add(records[i]);
+        else
+            encoder->add(records[i].function, records[i].rc, records[i].severity, records[i].timestamp, records[i].counter);
+    }
+    encoder->flush();
+    fclose(file);
+    delete encoder;
+}
+
+/* decodes fileName in the form encodeRecords takes, timestamps back from g_epoch, returning how decoding ended */
+static ReturnCode decodeRecords(char const *fileName, std::vector<LogRecord> &records) {
+    FILE *file = fopen(fileName, "rb");
+    assert(file != nullptr);
+    LogDecoder *decoder = new(std::nothrow) LogDecoder(file);
+    assert(decoder != nullptr);
+    LogRecord record;
+    size_t dropped;
+    ReturnCode rc;
+    while ((rc = decoder->next(record, dropped)) == ReturnCode::RC_SUCCESS) {
+        if (dropped > 0)
+            record = makeRecord("", ReturnCode::RC_SUCCESS, 0, g_epoch, dropped);
+        record.timestamp -= g_epoch;
+        records.push_back(record);
+    }
+    fclose(file);
+    delete decoder;
+    return rc;
+}
+
+/* whether fileName decodes to exactly the records encodeRecords wrote */
+static bool roundTrips(char const *fileName, std::vector<LogRecord> const &records) {
+    encodeRecords(fileName, records);
+    std::vector<LogRecord> decoded;
+    if (decodeRecords(fileName, decoded) != ReturnCode::RC_ELEM_NOT_FOUND || decoded.size() != records.size())
+        return false;
+    for (size_t i = 0; i < records.size(); ++i) {
+        bool dropped = records[i].function[0] == '\0';
+        if (dropped ? decoded[i].function[0] != '\0' || decoded[i].counter != records[i].counter : !sameRecord(decoded[i], records[i]))
+            return false;
+    }
+    return true;
+}
+
+static void writeBytes(char const *fileName, std::vector<unsigned char> const &bytes) {
+    FILE *file = fopen(fileName, "wb");
+    assert(file != nullptr);
+    if (!bytes.empty())
+        fwrite(bytes.data(), 1, bytes.size(), file);
+    fclose(file);
+}
+
+static std::vector<unsigned char> readBytes(char const *fileName) {
+    std::vector<unsigned char> bytes;
+    FILE *file = fopen(fileName, "rb");
+    assert(file != nullptr);
+    int byte;
+    while ((byte = fgetc(file)) != EOF)
+        bytes.push_back((unsigned char)byte);
+    fclose(file);
+    return bytes;
+}
+
+bool LogCodec_Records_RoundTrip(ILogger *logger, char *&testName) {
+    std::vector<LogRecord> records;
+    for (size_t i = 0; i < 3 * g_records; ++i) {
+        char name[32];
+        snprintf(name, sizeof(name), "site%zu", i % 7);
+        records.push_back(makeRecord(name, (ReturnCode)(i % ((size_t)ReturnCode::RC_UNKNOWN + 1)), (int)(i % 4),
+                                     (int64_t)(i * i), i + 1));
+    }
+    bool passed = roundTrips("TestLoggerCodec.bin", records);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool LogCodec_CollidingSites_NamesKept(ILogger *logger, char *&testName) {
+    /* more names than site slots, so some share a slot, logged alternately twice over */
+    std::vector<LogRecord> records;
+    for (size_t i = 0; i < 2 * 3000; ++i) {
+        char name[32];
+        snprintf(name, sizeof(name), "collidingSite%zu", i % 3000);
+        records.push_back(makeRecord(name, ReturnCode::RC_NAN, 3, (int64_t)i, i + 1));
+    }
+    bool passed = roundTrips("TestLoggerCodecCollisions.bin", records);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool LogCodec_LongName_Truncated(ILogger *logger, char *&testName) {
+    /* straight through the encoder, as a LogRecord cannot hold the long name */
+    std::string name(2 * LogRecord::FUNCTION_SIZE, 'n');
+    LogEncoder *encoder = new(std::nothrow) LogEncoder();
+    assert(encoder != nullptr);
+    FILE *file = fopen("TestLoggerCodecLong.bin", "wb");
+    assert(file != nullptr);
+    encoder->reset(file, g_epoch);
+    encoder->add(name.c_str(), ReturnCode::RC_NAN, 3, 0, 1);
+    encoder->add(name.c_str(), ReturnCode::RC_NAN, 3, 0, 2);
+    encoder->flush();
+    fclose(file);
+    delete encoder;
+
+    std::vector<LogRecord> decoded;
+    bool passed = decodeRecords("TestLoggerCodecLong.bin", decoded) == ReturnCode::RC_ELEM_NOT_FOUND && decoded.size() == 2;
+    for (size_t i = 0; passed && i < decoded.size(); ++i)
+        passed = name.compare(0, LogRecord::FUNCTION_SIZE - 1, decoded[i].function) == 0;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool LogCodec_NegativeDeltas_RoundTrip(ILogger *logger, char *&testName) {
+    /* an overwriting queue and clock steps can put records out of order */
+    std::vector<LogRecord> records;
+    records.push_back(makeRecord("later", ReturnCode::RC_NAN, 3, 5000000, 100));
+    records.push_back(makeRecord("earlier", ReturnCode::RC_NAN, 3, 1000, 3));
+    records.push_back(makeRecord("later", ReturnCode::RC_NAN, 3, 5000001, 101));
+    records.push_back(makeRecord("negative", ReturnCode::RC_NAN, 3, -42, 1));
+    bool passed = roundTrips("TestLoggerCodecNegative.bin", records);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool LogCodec_DroppedAndRepeated_RoundTrip(ILogger *logger, char *&testName) {
+    std::vector<LogRecord> records;
+    records.push_back(makeRecord("first", ReturnCode::RC_NAN, 3, 1000, 1));
+    records.push_back(makeRecord("", ReturnCode::RC_SUCCESS, 0, 0, 17));
+    LogRecord summary = makeRecord("first", ReturnCode::RC_NAN, 3, 2000, 2);
+    summary.repeated = 250;
+    summary.span = 999;
+    records.push_back(summary);
+    records.push_back(makeRecord("", ReturnCode::RC_SUCCESS, 0, 0, 1u << 20));
+    records.push_back(makeRecord("second", ReturnCode::RC_OPEN_FILE, 2, 3000, 3));
+    bool passed = roundTrips("TestLoggerCodecDropped.bin", records);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool LogDecoder_TruncatedInput_InvalidParams(ILogger *logger, char *&testName) {
+    std::vector<LogRecord> records;
+    records.push_back(makeRecord("first", ReturnCode::RC_NAN, 3, 1000, 1));
+    LogRecord summary = makeRecord("second", ReturnCode::RC_NAN, 3, 2000, 2);
+    summary.repeated = 300;
+    summary.span = 1500;
+    records.push_back(summary);
+    records.push_back(makeRecord("", ReturnCode::RC_SUCCESS, 0, 0, 300));
+    records.push_back(makeRecord("third", ReturnCode::RC_NAN, 3, 3000000, 3));
+    encodeRecords("TestLoggerCodecTruncated.bin", records);
+    std::vector<unsigned char> bytes = readBytes("TestLoggerCodecTruncated.bin");
+
+    /* a cut between entries reads as a shorter log, any other cut is malformed */
+    bool passed = !bytes.empty();
+    for (size_t length = 0; passed && length < bytes.size(); ++length) {
+        writeBytes("TestLoggerCodecTruncated.bin", std::vector<unsigned char>(bytes.begin(), bytes.begin() + length));
+        std::vector<LogRecord> decoded;
+        ReturnCode rc = decodeRecords("TestLoggerCodecTruncated.bin", decoded);
+        passed = (rc == ReturnCode::RC_INVALID_PARAMS || rc == ReturnCode::RC_ELEM_NOT_FOUND) && decoded.size() < records.size();
+        for (size_t i = 0; passed && i < decoded.size(); ++i)
+            passed = records[i].function[0] == '\0' ? decoded[i].counter == records[i].counter : sameRecord(decoded[i], records[i]);
+    }
+    /* the last entry is a record, so dropping its last byte cuts it */
+    passed = passed && bytes.size() > 1;
+    if (passed) {
+        writeBytes("TestLoggerCodecTruncated.bin", std::vector<unsigned char>(bytes.begin(), bytes.end() - 1));
+        std::vector<LogRecord> decoded;
+        passed = decodeRecords("TestLoggerCodecTruncated.bin", decoded) == ReturnCode::RC_INVALID_PARAMS && decoded.size() == 3;
+    }
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool LogDecoder_CorruptInput_InvalidParams(ILogger *logger, char *&testName) {
+    /* a header and a two byte dropped entry */
+    std::vector<LogRecord> records;
+    records.push_back(makeRecord("", ReturnCode::RC_SUCCESS, 0, 0, 1));
+    encodeRecords("TestLoggerCodecCorrupt.bin", records);
+    std::vector<unsigned char> bytes = readBytes("TestLoggerCodecCorrupt.bin");
+    bool passed = bytes.size() > 2 + 5;
+    size_t header = bytes.size() - 2;
+
+    std::vector<std::vector<unsigned char> > corrupt;
+    /* empty file, wrong magic, wrong version */
+    corrupt.push_back(std::vector<unsigned char>());
+    corrupt.push_back(bytes);
+    corrupt.back()[0] = 'X';
+    corrupt.push_back(bytes);
+    corrupt.back()[4] = (unsigned char)(LogEncoder::VERSION - 1);
+    /* unknown entry kind */
+    corrupt.push_back(bytes);
+    corrupt.back().push_back(0x7F);
+    /* a site id out of range */
+    corrupt.push_back(std::vector<unsigned char>(bytes.begin(), bytes.begin() + header));
+    unsigned char site[] = {LOG_ENTRY_SITE, 0xFF, 0x7F, 1, 'x'};
+    corrupt.back().insert(corrupt.back().end(), site, site + sizeof(site));
+    /* a site name longer than a record holds */
+    corrupt.push_back(std::vector<unsigned char>(bytes.begin(), bytes.begin() + header));
+    unsigned char longSite[] = {LOG_ENTRY_SITE, 0, (unsigned char)LogRecord::FUNCTION_SIZE};
+    corrupt.back().insert(corrupt.back().end(), longSite, longSite + sizeof(longSite));
+    corrupt.back().insert(corrupt.back().end(), LogRecord::FUNCTION_SIZE, 'x');
+    /* a varint that never ends */
+    corrupt.push_back(bytes);
+    corrupt.back().push_back(LOG_ENTRY_DROPPED);
+    corrupt.back().insert(corrupt.back().end(), 16, 0xFF);
+
+    for (size_t i = 0; passed && i < corrupt.size(); ++i) {
+        writeBytes("TestLoggerCodecCorrupt.bin", corrupt[i]);
+        std::vector<LogRecord> decoded;
+        passed = decodeRecords("TestLoggerCodecCorrupt.bin", decoded) == ReturnCode::RC_INVALID_PARAMS;
+    }
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setLogFile_Binary_EpochTimestamps(ILogger *logger, char *&testName) {
+    int64_t before = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    logger->setLogFile("TestLoggerBinary.bin", ILogger::Format::FORMAT_BINARY);
+    logger->log("binaryRecord", ReturnCode::RC_NAN);
+    logger->flush();
+    logger->setLogFile("TestLogger.log");
+    int64_t after = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    std::vector<LogRecord> decoded;
+    bool passed = decodeRecords("TestLoggerBinary.bin", decoded) == ReturnCode::RC_ELEM_NOT_FOUND && decoded.size() == 1;
+    /* the monotonic clock is coarse, so allow it a second either way */
+    int64_t timestamp = passed ? decoded[0].timestamp + g_epoch : 0;
+    passed = passed && strcmp(decoded[0].function, "binaryRecord") == 0 && timestamp > before - 1000000 && timestamp < after + 1000000;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool log_RateLimitDefault_AllWritten(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerRateDefault.log");
+    for (size_t i = 0; i < 100; ++i)
+        logger->log("defaultSite", ReturnCode::RC_NAN);
+    logger->flush();
+
+    bool passed = readLines("TestLoggerRateDefault.log").size() == 100;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setRateLimit_Burst_RestCountedOnFlush(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerRateBurst.log");
+    bool passed = ILogger::setRateLimit(4, 100000) == ReturnCode::RC_SUCCESS;
+    for (size_t i = 0; i < 20; ++i)
+        logger->log("burstSite", ReturnCode::RC_NAN);
+    /* another ReturnCode is another pair */
+    logger->log("burstSite", ReturnCode::RC_NULL_PTR);
+    logger->flush();
+    ILogger::setRateLimit(0);
+
+    std::vector<std::string> lines = readLines("TestLoggerRateBurst.log");
+    passed = passed && lines.size() == 6;
+    for (size_t i = 0; passed && i < 5; ++i)
+        passed = functionOf(lines[i]) == "burstSite" && repeatedOf(lines[i]) == 0;
+    passed = passed && functionOf(lines[5]) == "burstSite" && repeatedOf(lines[5]) == 16;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setRateLimit_PeriodElapsed_SummaryBeforeRecord(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerRatePeriod.log");
+    bool passed = ILogger::setRateLimit(2, 50) == ReturnCode::RC_SUCCESS;
+    for (size_t i = 0; i < 10; ++i)
+        logger->log("periodSite", ReturnCode::RC_NAN);
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    logger->log("periodSite", ReturnCode::RC_NAN);
+    logger->flush();
+    ILogger::setRateLimit(0);
+
+    std::vector<std::string> lines = readLines("TestLoggerRatePeriod.log");
+    passed = passed && lines.size() == 4 && repeatedOf(lines[0]) == 0 && repeatedOf(lines[1]) == 0 &&
+             functionOf(lines[2]) == "periodSite" && repeatedOf(lines[2]) == 8 && repeatedOf(lines[3]) == 0;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setRateLimit_SlotTaken_EvictedSummary(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerRateEvict.log");
+    bool passed = ILogger::setRateLimit(1, 100000) == ReturnCode::RC_SUCCESS;
+    /* one buffer with new text takes the slot of the old text */
+    char name[32] = "evictedSite";
+    for (size_t i = 0; i < 5; ++i)
+        logger->log(name, ReturnCode::RC_NAN);
+    strcpy(name, "evictingSite");
+    logger->log(name, ReturnCode::RC_NAN);
+    logger->flush();
+    ILogger::setRateLimit(0);
+
+    std::vector<std::string> lines = readLines("TestLoggerRateEvict.log");
+    passed = passed && lines.size() == 3 && functionOf(lines[0]) == "evictedSite" &&
+             functionOf(lines[1]) == "evictedSite" && repeatedOf(lines[1]) == 4 &&
+             functionOf(lines[2]) == "evictingSite" && repeatedOf(lines[2]) == 0;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+static void logThreadSite(ILogger *logger) {
+    for (size_t i = 0; i < 10; ++i)
+        logger->log("threadSite", ReturnCode::RC_NAN);
+}
+
+bool setRateLimit_ThreadExit_Summary(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestLoggerRateThread.log");
+    bool passed = ILogger::setRateLimit(1, 100000) == ReturnCode::RC_SUCCESS;
+    /* nothing flushes the thread's counts but its exit */
+    std::thread thread(logThreadSite, logger);
+    thread.join();
+    logger->flush();
+    ILogger::setRateLimit(0);
+
+    std::vector<std::string> lines = readLines("TestLoggerRateThread.log");
+    passed = passed && lines.size() == 2 && repeatedOf(lines[0]) == 0 &&
+             functionOf(lines[1]) == "threadSite" && repeatedOf(lines[1]) == 9;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+#endif //TESTLOGGER_H
@@ -42,7 +42,9 @@ int main() {
     tests.push_back(eraseByIndex_LastExistingElement_SuccessAnd0Dim);
     tests.push_back(eraseByIndex_ExistingElement_Success);
     tests.push_back(clear_Ok_Success);
+    tests.push_back(distances_Ok_MatrixValues);
     tests.push_back(find_NullPtr_NotSuccess);
+    tests.push_back(find_SameNormElements_Index);
     tests.push_back(find_WrongDim_NotSuccess);
     tests.push_back(find_NaNTolerance_NotSuccess);
     tests.push_back(find_NegativeTolerance_NotSuccess);
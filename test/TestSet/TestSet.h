@@ -543,6 +543,64 @@ bool clear_Ok_Success(ILogger *logger, char *&testName) {
     return passed;
 }
 
+bool find_SameNormElements_Index(ILogger *logger, char *&testName) {
+    ISet *set = ISet::createSet(logger);
+    assert(set != nullptr);
+
+    double coords[4][g_dim2] = {{3.0, 4.0}, {5.0, 0.0}, {1.0, 1.0}, {4.0, 3.0}};
+    ReturnCode rc;
+    for (size_t i = 0; i < 4; ++i) {
+        IVector *vec = IVector::createVector(g_dim2, coords[i], logger);
+        assert(vec != nullptr);
+        rc = set->insert(vec, IVector::Norm::NORM_2, EPS);
+        assert(rc == ReturnCode::RC_SUCCESS);
+        delete vec;
+    }
+
+    double query[g_dim2] = {1.0 + EPS / 4, 1.0};
+    IVector *nearVec = IVector::createVector(g_dim2, query, logger);
+    assert(nearVec != nullptr);
+    IVector *sameNormVec = IVector::createVector(g_dim2, coords[3], logger);
+    assert(sameNormVec != nullptr);
+
+    size_t nearIndex, sameNormIndex;
+    ReturnCode rcNear = set->find(nearVec, IVector::Norm::NORM_2, EPS, nearIndex);
+    ReturnCode rcSameNorm = set->find(sameNormVec, IVector::Norm::NORM_2, EPS, sameNormIndex);
+    bool passed = (set->getSize() == 4 && rcNear == ReturnCode::RC_SUCCESS && nearIndex == 2 &&
+                   rcSameNorm == ReturnCode::RC_SUCCESS && sameNormIndex == 3);
+    delete nearVec;
+    delete sameNormVec;
+    delete set;
+
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool distances_Ok_MatrixValues(ILogger *logger, char *&testName) {
+    ISet *set1 = ISet::createSet(logger);
+    assert(set1 != nullptr);
+    ISet *set2 = ISet::createSet(logger);
+    assert(set2 != nullptr);
+
+    double coords[3][g_dim2] = {{g_data21[0], g_data21[1]}, {g_data22[0], g_data22[1]}, {0.0, 0.0}};
+    for (size_t i = 0; i < 3; ++i) {
+        IVector *vec = IVector::createVector(g_dim2, coords[i], logger);
+        assert(vec != nullptr);
+        ReturnCode rc = (i < 2 ? set1 : set2)->insert(vec, IVector::Norm::NORM_2, EPS);
+        assert(rc == ReturnCode::RC_SUCCESS);
+        delete vec;
+    }
+
+    double matrix[2];
+    ReturnCode rc = ISet::distances(set1, set2, IVector::Norm::NORM_2, matrix, logger);
+    bool passed = (rc == ReturnCode::RC_SUCCESS && std::fabs(matrix[0] - std::sqrt(5.0)) < EPS && std::fabs(matrix[1] - 3.0) < EPS);
+    delete set1;
+    delete set2;
+
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
 bool find_NullPtr_NotSuccess(ILogger *logger, char *&testName) {
     ISet *set = ISet::createSet(logger);
     assert(set != nullptr);
@@ -1508,12 +1566,13 @@ bool intersection_DiffIntersecting_ISetPtr(ILogger *logger, char *&testName) {
     rc = intsctSet->get(intsctVecAfter, 0);
     assert(intsctVecAfter != nullptr);
     bool isEqual;
-    rc = IVector::equals(vec1, intsctVecAfter, IVector::Norm::NORM_1, EPS, isEqual, logger);
+    rc = IVector::equals(intsctVec, intsctVecAfter, IVector::Norm::NORM_1, EPS, isEqual, logger);
     assert(rc == ReturnCode::RC_SUCCESS);
 
     bool passed = (intsctSet != nullptr && intsctSet->getSize() == 1 && isEqual);
     delete intsctSet;
     delete intsctVecAfter;
+    delete intsctVec;
 
     testName = const_cast<char *>(__FUNCTION__);
     return passed;
@@ -32,12 +32,16 @@ int main() {
     tests.push_back(norm_Ok_Norm1Value);
     tests.push_back(norm_Ok_Norm2Value);
     tests.push_back(norm_Ok_NormInfValue);
+    tests.push_back(norm_LongVector_ScalarValues);
     tests.push_back(equal_NullPtr_NullPtr);
     tests.push_back(equal_WrongDim_NullPtr);
     tests.push_back(equal_InvalidNorm_NullPtr);
     tests.push_back(equal_NaNTolerance_NullPtr);
     tests.push_back(equal_Ok_NotSuccess);
     tests.push_back(equal_Ok_Success);
+    tests.push_back(distance_WrongDim_NaN);
+    tests.push_back(distance_Ok_DistanceValues);
+    tests.push_back(withinTolerance_LongVector_Success);
     tests.push_back(add_NullPtr_NullPtr);
     tests.push_back(add_WrongDim_NullPtr);
     tests.push_back(add_Ok_IVectorPtr);
@@ -50,6 +54,46 @@ int main() {
     tests.push_back(mul_NullPtr_NullPtr);
     tests.push_back(mul_WrongDim_NullPtr);
     tests.push_back(mul_Ok_IVectorPtr);
+    tests.push_back(addInPlace_WrongDim_NotSuccess);
+    tests.push_back(axpy_Ok_Success);
+    tests.push_back(lincomb_Aliased_Success);
+    tests.push_back(norm_AfterWrite_UpdatedValue);
+    tests.push_back(clone_LongVector_CopyOnWrite);
+    tests.push_back(clone_AfterGetData_Independent);
+    tests.push_back(getData_Ok_CoordsPtr);
+    tests.push_back(getCoords_OutOfBounds_NotSuccess);
+    tests.push_back(setCoords_NaNValue_Unchanged);
+    tests.push_back(createVectorAdopt_NaNValue_NullPtr);
+    tests.push_back(createVectorAdopt_Ok_SameBuffer);
+    tests.push_back(createVector_FloatStorage_Values);
+    tests.push_back(convert_Ok_IVectorPtr);
+    tests.push_back(createSparseVector_UnsortedIndices_NullPtr);
+    tests.push_back(sparse_MixedWithDense_Values);
+    tests.push_back(sparseSetCoord_Ok_Values);
+    tests.push_back(createView_ZeroStride_NullPtr);
+    tests.push_back(createView_Strided_ColumnValues);
+    tests.push_back(fixedVector_Ok_Values);
+    tests.push_back(fixedVector_MixedWithIVector_Success);
+    tests.push_back(evaluateExpr_Ok_FusedValues);
+    tests.push_back(assignExpr_WrongDim_NotSuccess);
+    tests.push_back(assignExpr_NaNResult_Untouched);
+    tests.push_back(assignExpr_LongVector_CloneShared);
+    tests.push_back(createArena_WrongSize_NullPtr);
+    tests.push_back(arenaAdd_Ok_IVectorPtr);
+    tests.push_back(arenaClone_Ok_HeapIVectorPtr);
+    tests.push_back(createBatch_NullPtr_NullPtr);
+    tests.push_back(createBatch_Ok_IVectorBatchPtr);
+    tests.push_back(batchSub_Ok_IVectorBatchPtr);
+    tests.push_back(batchMul_WrongDim_NotSuccess);
+    tests.push_back(batchNorm_Ok_Norm2Values);
+    tests.push_back(batchDistances_LargeBatches_MatrixValues);
+    tests.push_back(setExecution_Parallel_ReproducibleResults);
+    tests.push_back(poolEnable_Ok_RecyclesVectors);
+    tests.push_back(lincombMany_Ok_WeightedSum);
+    tests.push_back(hash_NearbyVectors_NeighbourKey);
+    tests.push_back(batchHash_Ok_RowKeys);
+    /* last, as it moves the log to its own file */
+    tests.push_back(assignExpr_Error_LoggedUnderEntryPoint);
 
     int testCounter = 0;
     int passedTestConter = 0;
@@ -4,10 +4,16 @@
 #include <new>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 
 #include "../include/ILogger.h"
 #include "../include/IVector.h"
+#include "../include/IVectorBatch.h"
+#include "../include/IVectorArena.h"
+#include "../include/IVectorPool.h"
+#include "../include/FixedVector.h"
+#include "../include/VectorExpr.h"
 
 #define EPS 1e-6
 
@@ -19,6 +25,8 @@ static const double  (&g_data1)[g_dim1] = {-1.0};
 static const double  (&g_data1Nan)[g_dim1] = {NAN};
 static const double  (&g_data2)[g_dim2] = {-1.0, 2.0};
 
+static const size_t g_dimLong = 67;
+
 
 bool createVector_WrongDim_NullPtr(ILogger *logger, char *&testName) {
     IVector *vecNull = IVector::createVector(g_dim0, nullptr, logger);
@@ -180,6 +188,28 @@ bool norm_Ok_NormInfValue(ILogger *logger, char *&testName) {
     return normValue == (std::fabs(g_data2[0]) > std::fabs(g_data2[1]) ? std::fabs(g_data2[0]) : std::fabs(g_data2[1]));
 }
 
+bool norm_LongVector_ScalarValues(ILogger *logger, char *&testName) {
+    double data[g_dimLong];
+    double norm1 = 0, norm2 = 0, normInf = 0, dot = 0;
+    for (size_t i = 0; i < g_dimLong; ++i) {
+        data[i] = (i % 2 ? -1.0 : 1.0) * (0.5 + (double) ((i * 37) % 101) / 7);
+        norm1 += std::fabs(data[i]);
+        norm2 += data[i] * data[i];
+        normInf = std::fabs(data[i]) > normInf ? std::fabs(data[i]) : normInf;
+        dot += data[i] * data[i];
+    }
+    IVector *vecLong = IVector::createVector(g_dimLong, data, logger);
+    assert(vecLong != nullptr);
+
+    bool passed = (std::fabs(vecLong->norm(IVector::Norm::NORM_1) - norm1) < EPS &&
+                   std::fabs(vecLong->norm(IVector::Norm::NORM_2) - std::sqrt(norm2)) < EPS &&
+                   vecLong->norm(IVector::Norm::NORM_INF) == normInf &&
+                   std::fabs(IVector::mul(vecLong, vecLong, logger) - dot) < EPS);
+    delete vecLong;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
 bool equal_NullPtr_NullPtr(ILogger *logger, char *&testName) {
     bool isEqual;
     ReturnCode rc = IVector::equals(nullptr, nullptr, IVector::Norm::NORM_1, EPS, isEqual, logger);
@@ -276,6 +306,62 @@ bool equal_Ok_Success(ILogger *logger, char *&testName) {
     return rc == ReturnCode::RC_SUCCESS && isEqual;
 }
 
+bool distance_WrongDim_NaN(ILogger *logger, char *&testName) {
+    double *data2 = new(std::nothrow) double[g_dim2];
+    assert(data2 != nullptr);
+    std::memcpy(data2, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data2, logger);
+    assert(vec2 != nullptr);
+    double *data1 = new(std::nothrow) double[g_dim1];
+    assert(data1 != nullptr);
+    std::memcpy(data1, g_data1, g_dim1 * sizeof(double));
+    IVector *vec1 = IVector::createVector(g_dim1, data1, logger);
+    assert(vec1 != nullptr);
+
+    double dist = IVector::distance(vec2, vec1, IVector::Norm::NORM_2, logger);
+    delete vec2;
+    delete vec1;
+    testName = const_cast<char *>(__FUNCTION__);
+    return std::isnan(dist);
+}
+
+bool distance_Ok_DistanceValues(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    IVector *mulVec = IVector::mul(vec2, -1.0, logger);
+    assert(mulVec != nullptr);
+
+    bool passed = (std::fabs(IVector::distance(vec2, mulVec, IVector::Norm::NORM_1, logger) - 2 * (std::fabs(g_data2[0]) + std::fabs(g_data2[1]))) < EPS &&
+                   std::fabs(IVector::distance(vec2, mulVec, IVector::Norm::NORM_2, logger) - 2 * vec2->norm(IVector::Norm::NORM_2)) < EPS &&
+                   std::fabs(IVector::distance(vec2, mulVec, IVector::Norm::NORM_INF, logger) - 2 * vec2->norm(IVector::Norm::NORM_INF)) < EPS);
+    delete vec2;
+    delete mulVec;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool withinTolerance_LongVector_Success(ILogger *logger, char *&testName) {
+    double data[g_dimLong];
+    for (size_t i = 0; i < g_dimLong; ++i)
+        data[i] = (double) i;
+    IVector *vecLong = IVector::createVector(g_dimLong, data, logger);
+    assert(vecLong != nullptr);
+    IVector *shifted = vecLong->clone();
+    assert(shifted != nullptr);
+    shifted->setCoord(g_dimLong - 1, data[g_dimLong - 1] + 0.5);
+
+    bool isNear, isFar;
+    ReturnCode rcNear = IVector::withinTolerance(vecLong, shifted, IVector::Norm::NORM_2, 0.6, isNear, logger);
+    ReturnCode rcFar = IVector::withinTolerance(vecLong, shifted, IVector::Norm::NORM_1, 0.4, isFar, logger);
+    delete vecLong;
+    delete shifted;
+    testName = const_cast<char *>(__FUNCTION__);
+    return rcNear == ReturnCode::RC_SUCCESS && isNear && rcFar == ReturnCode::RC_SUCCESS && !isFar;
+}
+
 bool add_NullPtr_NullPtr(ILogger *logger, char *&testName) {
     IVector *addVec = IVector::add(nullptr, nullptr, logger);
 
@@ -456,5 +542,774 @@ bool mul_Ok_IVectorPtr(ILogger *logger, char *&testName) {
     return (std::fabs(prod - (g_data2[0] * g_data2[0] + g_data2[1] * g_data2[1])) < EPS);
 }
 
+bool addInPlace_WrongDim_NotSuccess(ILogger *logger, char *&testName) {
+    double *data2 = new(std::nothrow) double[g_dim2];
+    assert(data2 != nullptr);
+    std::memcpy(data2, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data2, logger);
+    assert(vec2 != nullptr);
+    double *data1 = new(std::nothrow) double[g_dim1];
+    assert(data1 != nullptr);
+    std::memcpy(data1, g_data1, g_dim1 * sizeof(double));
+    IVector *vec1 = IVector::createVector(g_dim1, data1, logger);
+    assert(vec1 != nullptr);
+
+    ReturnCode rc = IVector::addInPlace(vec2, vec1, logger);
+    bool passed = (rc != ReturnCode::RC_SUCCESS && vec2->getCoord(0) == g_data2[0] && vec2->getCoord(1) == g_data2[1]);
+    delete vec2;
+    delete vec1;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool axpy_Ok_Success(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    IVector *clonedVec2 = vec2->clone();
+    assert(clonedVec2 != nullptr);
+
+    ReturnCode rc = IVector::axpy(clonedVec2, 3.0, vec2, logger);
+    bool passed = (rc == ReturnCode::RC_SUCCESS && std::fabs(clonedVec2->getCoord(0) - 4 * g_data2[0]) < EPS && std::fabs(clonedVec2->getCoord(1) - 4 * g_data2[1]) < EPS);
+    delete vec2;
+    delete clonedVec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool lincomb_Aliased_Success(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    IVector *clonedVec2 = vec2->clone();
+    assert(clonedVec2 != nullptr);
+
+    ReturnCode rcScale = IVector::scaleInPlace(clonedVec2, 2.0, logger);
+    ReturnCode rcSub = IVector::subInPlace(clonedVec2, vec2, logger);
+    ReturnCode rc = IVector::lincomb(vec2, 2.0, vec2, -1.0, clonedVec2, logger);
+    bool passed = (rcScale == ReturnCode::RC_SUCCESS && rcSub == ReturnCode::RC_SUCCESS && rc == ReturnCode::RC_SUCCESS &&
+                   std::fabs(vec2->getCoord(0) - g_data2[0]) < EPS && std::fabs(vec2->getCoord(1) - g_data2[1]) < EPS);
+    delete vec2;
+    delete clonedVec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool norm_AfterWrite_UpdatedValue(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+
+    double normBefore = vec2->norm(IVector::Norm::NORM_1);
+    vec2->setCoord(0, 4.0);
+    double normSet = vec2->norm(IVector::Norm::NORM_1);
+    vec2->getData()[1] = -1.0;
+    double normWritten = vec2->norm(IVector::Norm::NORM_1);
+    bool passed = (normBefore == 3.0 && normSet == 6.0 && normWritten == 5.0 && vec2->norm(IVector::Norm::NORM_1) == 5.0);
+    delete vec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool clone_LongVector_CopyOnWrite(ILogger *logger, char *&testName) {
+    double data[g_dimLong];
+    for (size_t i = 0; i < g_dimLong; ++i)
+        data[i] = static_cast<double>(i);
+    IVector *vec = IVector::createVector(g_dimLong, data, logger);
+    assert(vec != nullptr);
+    IVector *cloned = vec->clone();
+    assert(cloned != nullptr);
+    IVector const *constVec = vec, *constCloned = cloned;
+
+    bool shared = (constVec->getData() == constCloned->getData());
+    ReturnCode rc = cloned->setCoord(1, -1.0);
+    bool passed = (shared && rc == ReturnCode::RC_SUCCESS && constVec->getData() != constCloned->getData() &&
+                   vec->getCoord(1) == 1.0 && cloned->getCoord(1) == -1.0 && cloned->getCoord(66) == 66.0);
+    delete vec;
+    delete cloned;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool clone_AfterGetData_Independent(ILogger *logger, char *&testName) {
+    double data[g_dimLong];
+    for (size_t i = 0; i < g_dimLong; ++i)
+        data[i] = static_cast<double>(i);
+    IVector *vec = IVector::createVector(g_dimLong, data, logger);
+    assert(vec != nullptr);
+
+    double *coords = vec->getData();
+    assert(coords != nullptr);
+    IVector *cloned = vec->clone();
+    assert(cloned != nullptr);
+    coords[1] = -1.0;
+    double normBefore = vec->norm(IVector::Norm::NORM_INF);
+    coords[2] = 1000.0;
+
+    bool passed = (vec->getCoord(1) == -1.0 && cloned->getCoord(1) == 1.0 && cloned->getCoord(2) == 2.0 &&
+                   normBefore == static_cast<double>(g_dimLong - 1) && vec->norm(IVector::Norm::NORM_INF) == 1000.0 &&
+                   cloned->norm(IVector::Norm::NORM_INF) == static_cast<double>(g_dimLong - 1));
+    delete vec;
+    delete cloned;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool getData_Ok_CoordsPtr(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+
+    double *coords = vec2->getData();
+    bool passed = (coords != nullptr && coords[0] == g_data2[0] && coords[1] == g_data2[1]);
+    if (passed) {
+        coords[1] = 3.0;
+        passed = (vec2->getCoord(1) == 3.0);
+    }
+    delete vec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool getCoords_OutOfBounds_NotSuccess(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+
+    double coords[g_dim2];
+    ReturnCode rcGet = vec2->getCoords(1, g_dim2, coords);
+    ReturnCode rcSet = vec2->setCoords(g_dim2 + 1, 0, g_data2);
+    bool passed = (rcGet == ReturnCode::RC_OUT_OF_BOUNDS && rcSet == ReturnCode::RC_OUT_OF_BOUNDS);
+    delete vec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setCoords_NaNValue_Unchanged(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+
+    double const values[g_dim2] = {5.0, NAN};
+    ReturnCode rc = vec2->setCoords(0, g_dim2, values);
+    bool passed = (rc == ReturnCode::RC_NAN && vec2->getCoord(0) == g_data2[0] && vec2->getCoord(1) == g_data2[1]);
+    delete vec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createVectorAdopt_NaNValue_NullPtr(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim1];
+    assert(data != nullptr);
+    data[0] = g_data1Nan[0];
+    IVector *vecNull = IVector::createVectorAdopt(g_dim1, data, false, logger);
+
+    bool passed = (vecNull == nullptr);
+    if (!passed) delete vecNull;
+    else delete[]data;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createVectorAdopt_Ok_SameBuffer(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVectorAdopt(g_dim2, data, true, logger);
+    assert(vec2 != nullptr);
+    IVector *cloned = vec2->clone();
+    assert(cloned != nullptr);
+
+    bool passed = (vec2->getData() == data && cloned->getData() != data && cloned->getCoord(1) == g_data2[1]);
+    delete vec2;
+    delete cloned;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createVector_FloatStorage_Values(ILogger *logger, char *&testName) {
+    double data[g_dimLong];
+    for (size_t i = 0; i < g_dimLong; ++i)
+        data[i] = 0.1 * (i % 5) - 0.2;
+    IVector *vecDouble = IVector::createVector(g_dimLong, data, logger);
+    assert(vecDouble != nullptr);
+    IVector *vecFloat = IVector::createVector(g_dimLong, data, IVector::Storage::STORAGE_FLOAT, logger);
+    assert(vecFloat != nullptr);
+
+    bool passed = (vecFloat->getData() == nullptr && vecFloat->getCoord(1) == static_cast<double>(static_cast<float>(data[1])) &&
+                   std::fabs(vecFloat->norm(IVector::Norm::NORM_2) - vecDouble->norm(IVector::Norm::NORM_2)) < EPS &&
+                   std::fabs(IVector::mul(vecFloat, vecDouble, logger) - IVector::mul(vecDouble, vecDouble, logger)) < EPS &&
+                   IVector::distance(vecFloat, vecDouble, IVector::Norm::NORM_INF, logger) < EPS);
+    delete vecDouble;
+    delete vecFloat;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool convert_Ok_IVectorPtr(ILogger *logger, char *&testName) {
+    double data[g_dim2] = {g_data2[0], g_data2[1]};
+    IVector *vecFloat = IVector::createVector(g_dim2, data, IVector::Storage::STORAGE_FLOAT, logger);
+    assert(vecFloat != nullptr);
+
+    IVector *vecDouble = IVector::convert(vecFloat, IVector::Storage::STORAGE_DOUBLE, logger);
+    IVector *vecNull = IVector::convert(nullptr, IVector::Storage::STORAGE_FLOAT, logger);
+    bool passed = (vecDouble != nullptr && vecNull == nullptr && vecDouble->getData() != nullptr &&
+                   vecDouble->getCoord(0) == g_data2[0] && vecDouble->getCoord(1) == g_data2[1]);
+    delete vecFloat;
+    delete vecDouble;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createSparseVector_UnsortedIndices_NullPtr(ILogger *logger, char *&testName) {
+    size_t const indices[g_dim2] = {3, 1};
+    IVector *vecNull = IVector::createSparseVector(g_dimLong, g_dim2, indices, g_data2, logger);
+
+    bool passed = (vecNull == nullptr);
+    if (!passed) delete vecNull;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool sparse_MixedWithDense_Values(ILogger *logger, char *&testName) {
+    size_t const indices1[3] = {2, 40, 66};
+    double const values1[3] = {1.0, -2.0, 3.0};
+    size_t const indices2[2] = {40, 50};
+    double const values2[2] = {2.0, 4.0};
+    IVector *sparse1 = IVector::createSparseVector(g_dimLong, 3, indices1, values1, logger);
+    assert(sparse1 != nullptr);
+    IVector *sparse2 = IVector::createSparseVector(g_dimLong, 2, indices2, values2, logger);
+    assert(sparse2 != nullptr);
+    double dense[g_dimLong];
+    sparse1->getCoords(0, g_dimLong, dense);
+    IVector *vecDense = IVector::createVector(g_dimLong, dense, logger);
+    assert(vecDense != nullptr);
+
+    IVector *sum = IVector::add(sparse1, sparse2, logger);
+    IVector *mixed = IVector::add(vecDense, sparse2, logger);
+    bool equal = false;
+    ReturnCode rc = IVector::equals(sum, mixed, IVector::Norm::NORM_INF, EPS, equal, logger);
+    bool passed = (sum != nullptr && mixed != nullptr && sum->getData() == nullptr && rc == ReturnCode::RC_SUCCESS && equal &&
+                   sum->getCoord(40) == 0.0 && sum->getCoord(50) == 4.0 && sparse1->getCoord(3) == 0.0 &&
+                   IVector::mul(sparse1, sparse2, logger) == -4.0 && IVector::mul(sparse2, vecDense, logger) == -4.0 &&
+                   std::fabs(IVector::distance(sparse1, sparse2, IVector::Norm::NORM_1, logger) - 12.0) < EPS &&
+                   sparse1->norm(IVector::Norm::NORM_INF) == 3.0);
+    delete sparse1;
+    delete sparse2;
+    delete vecDense;
+    delete sum;
+    delete mixed;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool sparseSetCoord_Ok_Values(ILogger *logger, char *&testName) {
+    IVector *sparse = IVector::createSparseVector(g_dimLong, 0, nullptr, nullptr, logger);
+    assert(sparse != nullptr);
+
+    double const block[3] = {1.0, 0.0, 2.0};
+    ReturnCode rcSet = sparse->setCoord(10, 5.0);
+    ReturnCode rcBlock = sparse->setCoords(9, 3, block);
+    ReturnCode rcZero = sparse->setCoord(9, 0.0);
+    ReturnCode rcScale = IVector::scaleInPlace(sparse, -2.0, logger);
+    bool passed = (rcSet == ReturnCode::RC_SUCCESS && rcBlock == ReturnCode::RC_SUCCESS && rcZero == ReturnCode::RC_SUCCESS &&
+                   rcScale == ReturnCode::RC_SUCCESS && sparse->getCoord(9) == 0.0 && sparse->getCoord(10) == 0.0 &&
+                   sparse->getCoord(11) == -4.0 && sparse->norm(IVector::Norm::NORM_1) == 4.0);
+    delete sparse;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createView_ZeroStride_NullPtr(ILogger *logger, char *&testName) {
+    double data[g_dim2] = {g_data2[0], g_data2[1]};
+    IVector *viewNull = IVector::createView(g_dim2, data, 0, logger);
+
+    bool passed = (viewNull == nullptr);
+    if (!passed) delete viewNull;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createView_Strided_ColumnValues(ILogger *logger, char *&testName) {
+    double matrix[3 * g_dim2] = {1.0, -2.0, 3.0, -4.0, 5.0, -6.0};
+    IVector *column = IVector::createView(3, matrix + 1, g_dim2, logger);
+    assert(column != nullptr);
+    IVector *cloned = column->clone();
+    assert(cloned != nullptr);
+
+    ReturnCode rc = column->setCoord(2, 7.0);
+    bool passed = (rc == ReturnCode::RC_SUCCESS && column->getData() == nullptr && matrix[5] == 7.0 &&
+                   std::fabs(column->norm(IVector::Norm::NORM_1) - 13.0) < EPS &&
+                   std::fabs(cloned->norm(IVector::Norm::NORM_2) - std::sqrt(56.0)) < EPS &&
+                   std::fabs(IVector::distance(column, cloned, IVector::Norm::NORM_INF, logger) - 13.0) < EPS);
+    delete column;
+    delete cloned;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool fixedVector_Ok_Values(ILogger *logger, char *&testName) {
+    double const coords1[3] = {1.0, -2.0, 2.0};
+    double const coords2[3] = {0.5, 4.0, -1.0};
+    FixedVector<3> fixed1(coords1, logger);
+    FixedVector<3> fixed2(coords2, logger);
+
+    FixedVector<3> sum = FixedVector<3>::add(fixed1, fixed2);
+    FixedVector<3> diff = FixedVector<3>::sub(sum, fixed2);
+    bool passed = (sum.getCoord(0) == 1.5 && sum.getCoord(1) == 2.0 && sum.getCoord(2) == 1.0 &&
+                   FixedVector<3>::mul(fixed1, fixed2) == -9.5 && std::fabs(diff.norm(IVector::Norm::NORM_2) - 3.0) < EPS &&
+                   diff.norm(IVector::Norm::NORM_1) == 5.0 && diff.norm(IVector::Norm::NORM_INF) == 2.0);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool fixedVector_MixedWithIVector_Success(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    FixedVector<g_dim2> fixed2(g_data2, logger);
+    IVector *cloned = fixed2.clone();
+    assert(cloned != nullptr);
+
+    bool result = false;
+    ReturnCode rc = IVector::equals(vec2, cloned, IVector::Norm::NORM_2, EPS, result, logger);
+    IVector *sum = IVector::add(vec2, &fixed2, logger);
+    bool passed = (rc == ReturnCode::RC_SUCCESS && result && fixed2.setCoord(g_dim2, 0.0) == ReturnCode::RC_OUT_OF_BOUNDS &&
+                   sum != nullptr && sum->getCoord(1) == 2 * g_data2[1]);
+    delete vec2;
+    delete cloned;
+    delete sum;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool evaluateExpr_Ok_FusedValues(ILogger *logger, char *&testName) {
+    double const coords[3][g_dim2] = {{1.0, 2.0}, {3.0, -1.0}, {0.5, 0.5}};
+    FixedVector<g_dim2> a(coords[0], logger), b(coords[1], logger), c(coords[2], logger);
+
+    IVector *result = evaluateExpr(vexpr(&a) + 2 * (vexpr(&b) - vexpr(&c)), logger);
+    ReturnCode rc = assignExpr(&a, vexpr(&a) - 0.5 * vexpr(&a), logger);
+    bool passed = (result != nullptr && result->getCoord(0) == 6.0 && result->getCoord(1) == -1.0 &&
+                   rc == ReturnCode::RC_SUCCESS && a.getCoord(0) == 0.5 && a.getCoord(1) == 1.0);
+    delete result;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool assignExpr_WrongDim_NotSuccess(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    FixedVector<g_dim1> fixed1(g_data1, logger);
+
+    ReturnCode rcDim = assignExpr(vec2, vexpr(vec2) + vexpr(&fixed1), logger);
+    ReturnCode rcNull = assignExpr(vec2, vexpr(vec2) + vexpr(nullptr), logger);
+    ReturnCode rcNan = assignExpr(vec2, NAN * vexpr(vec2), logger);
+    bool passed = (rcDim == ReturnCode::RC_WRONG_DIM && rcNull == ReturnCode::RC_NULL_PTR && rcNan == ReturnCode::RC_NAN &&
+                   vec2->getCoord(0) == g_data2[0]);
+    delete vec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool assignExpr_NaNResult_Untouched(ILogger *logger, char *&testName) {
+    double const coords[g_dim2] = {1.0, INFINITY};
+    FixedVector<g_dim2> inf(coords, logger);
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+
+    /* only the second coordinate is inf - inf */
+    ReturnCode rc = assignExpr(vec2, vexpr(&inf) - vexpr(&inf), logger);
+    bool passed = (rc == ReturnCode::RC_NAN && vec2->getCoord(0) == g_data2[0] && vec2->getCoord(1) == g_data2[1]);
+    delete vec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool assignExpr_LongVector_CloneShared(ILogger *logger, char *&testName) {
+    double data[g_dimLong];
+    for (size_t i = 0; i < g_dimLong; ++i)
+        data[i] = static_cast<double>(i);
+    IVector *vec = IVector::createVector(g_dimLong, data, logger);
+    assert(vec != nullptr);
+
+    ReturnCode rc = assignExpr(vec, 2.0 * vexpr(vec), logger);
+    IVector *cloned = vec->clone();
+    assert(cloned != nullptr);
+    IVector const *constVec = vec, *constCloned = cloned;
+    bool passed = (rc == ReturnCode::RC_SUCCESS && constVec->getData() == constCloned->getData() &&
+                   vec->getCoord(g_dimLong - 1) == 2.0 * (g_dimLong - 1));
+    delete vec;
+    delete cloned;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+/* lines of a log file holding text */
+static size_t countLines(char const *fileName, char const *text) {
+    FILE *file = fopen(fileName, "r");
+    if (file == nullptr)
+        return 0;
+    size_t count = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        if (strstr(line, text) != nullptr)
+            count++;
+    }
+    fclose(file);
+    return count;
+}
+
+bool assignExpr_Error_LoggedUnderEntryPoint(ILogger *logger, char *&testName) {
+    logger->setLogFile("TestVectorExpr.log");
+    FixedVector<g_dim2> fixed2(g_data2, logger);
+    ReturnCode rc = assignExpr(&fixed2, vexpr(&fixed2) + vexpr(nullptr), logger);
+    IVector *result = evaluateExpr(NAN * vexpr(&fixed2), logger);
+    logger->flush();
+
+    bool passed = (rc == ReturnCode::RC_NULL_PTR && result == nullptr &&
+                   countLines("TestVectorExpr.log", "--Function:[assignExpr]--ReturnCode:[2]") == 1 &&
+                   countLines("TestVectorExpr.log", "--Function:[evaluateExpr]--ReturnCode:[5]") == 1 &&
+                   countLines("TestVectorExpr.log", "--Function:[validate]") == 0);
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createArena_WrongSize_NullPtr(ILogger *logger, char *&testName) {
+    IVectorArena *arenaNull = IVectorArena::createArena(0, logger);
+
+    bool passed = (arenaNull == nullptr);
+    if (!passed) delete arenaNull;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool arenaAdd_Ok_IVectorPtr(ILogger *logger, char *&testName) {
+    IVectorArena *arena = IVectorArena::createArena(64, logger);
+    assert(arena != nullptr);
+
+    double data[g_dim2];
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(arena, g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    IVector *clonedVec2 = IVector::clone(arena, vec2, logger);
+    assert(clonedVec2 != nullptr);
+
+    IVector *addVec = IVector::add(arena, vec2, clonedVec2, logger);
+    assert(addVec != nullptr);
+    bool passed = (std::fabs(addVec->getCoord(0) - 2 * g_data2[0]) < EPS && std::fabs(addVec->getCoord(1) - 2 * g_data2[1]) < EPS &&
+                   arena->getUsed() > 0 && arena->getCapacity() >= arena->getUsed());
+    delete clonedVec2;
+    arena->reset();
+    passed &= (arena->getUsed() == 0);
+    delete arena;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool arenaClone_Ok_HeapIVectorPtr(ILogger *logger, char *&testName) {
+    IVectorArena *arena = IVectorArena::createArena(16, logger);
+    assert(arena != nullptr);
+
+    double data[g_dim2];
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(arena, g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    IVector *heapVec2 = vec2->clone();
+    assert(heapVec2 != nullptr);
+    delete arena;
+
+    bool passed = (heapVec2->getCoord(0) == g_data2[0] && heapVec2->getCoord(1) == g_data2[1]);
+    delete heapVec2;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createBatch_NullPtr_NullPtr(ILogger *logger, char *&testName) {
+    IVectorBatch *batchNull = IVectorBatch::createBatch(g_dim2, g_dim2, nullptr, logger);
+
+    bool passed = (batchNull == nullptr);
+    if (!passed) delete batchNull;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool createBatch_Ok_IVectorBatchPtr(ILogger *logger, char *&testName) {
+    double *data = new(std::nothrow) double[g_dim2];
+    assert(data != nullptr);
+    std::memcpy(data, g_data2, g_dim2 * sizeof(double));
+    IVector *vec2 = IVector::createVector(g_dim2, data, logger);
+    assert(vec2 != nullptr);
+    IVector *mulVec = IVector::mul(vec2, 2.0, logger);
+    assert(mulVec != nullptr);
+
+    IVector const *vectors[g_dim2] = {vec2, mulVec};
+    IVectorBatch *batch = IVectorBatch::createBatch(vectors, g_dim2, logger);
+    assert(batch != nullptr);
+    IVector *row = batch->getVector(1);
+    assert(row != nullptr);
+
+    bool isEqual;
+    ReturnCode rc = IVector::equals(row, mulVec, IVector::Norm::NORM_INF, EPS, isEqual, logger);
+    bool passed = (rc == ReturnCode::RC_SUCCESS && isEqual && batch->getSize() == g_dim2 && batch->getDim() == g_dim2);
+    delete row;
+    delete batch;
+    delete vec2;
+    delete mulVec;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool batchSub_Ok_IVectorBatchPtr(ILogger *logger, char *&testName) {
+    IVectorBatch *batch = IVectorBatch::createBatch(g_dim1, g_dim2, g_data2, logger);
+    assert(batch != nullptr);
+    IVectorBatch *doubled = IVectorBatch::mul(batch, 2.0, logger);
+    assert(doubled != nullptr);
+
+    IVectorBatch *subBatch = IVectorBatch::sub(doubled, batch, logger);
+    assert(subBatch != nullptr);
+    bool passed = (std::fabs(subBatch->getCoord(0, 0) - g_data2[0]) < EPS && std::fabs(subBatch->getCoord(0, 1) - g_data2[1]) < EPS);
+    delete batch;
+    delete doubled;
+    delete subBatch;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool batchMul_WrongDim_NotSuccess(ILogger *logger, char *&testName) {
+    IVectorBatch *batch2 = IVectorBatch::createBatch(g_dim1, g_dim2, g_data2, logger);
+    assert(batch2 != nullptr);
+    IVectorBatch *batch1 = IVectorBatch::createBatch(g_dim1, g_dim1, g_data1, logger);
+    assert(batch1 != nullptr);
+
+    double prod;
+    ReturnCode rc = IVectorBatch::mul(batch2, batch1, &prod, logger);
+    delete batch2;
+    delete batch1;
+    testName = const_cast<char *>(__FUNCTION__);
+    return rc != ReturnCode::RC_SUCCESS;
+}
+
+bool batchNorm_Ok_Norm2Values(ILogger *logger, char *&testName) {
+    IVectorBatch *batch = IVectorBatch::createBatch(g_dim1, g_dim2, g_data2, logger);
+    assert(batch != nullptr);
+
+    double normValue;
+    ReturnCode rc = IVectorBatch::norm(batch, IVector::Norm::NORM_2, &normValue, logger);
+    delete batch;
+    testName = const_cast<char *>(__FUNCTION__);
+    return rc == ReturnCode::RC_SUCCESS && std::fabs(normValue - std::sqrt(g_data2[0] * g_data2[0] + g_data2[1] * g_data2[1])) < EPS;
+}
+
+
+bool batchDistances_LargeBatches_MatrixValues(ILogger *logger, char *&testName) {
+    /* not multiples of the 4 x 4 dot blocks, so ragged edges are covered too */
+    size_t const size1 = 203, size2 = 101;
+    double *data = new(std::nothrow) double[(size1 + size2) * g_dimLong];
+    assert(data != nullptr);
+    for (size_t i = 0; i < (size1 + size2) * g_dimLong; ++i)
+        data[i] = static_cast<double>((i * 7919) % 101) / 10 - 5;
+    IVectorBatch *batch1 = IVectorBatch::createBatch(size1, g_dimLong, data, logger);
+    assert(batch1 != nullptr);
+    IVectorBatch *batch2 = IVectorBatch::createBatch(size2, g_dimLong, data + size1 * g_dimLong, logger);
+    assert(batch2 != nullptr);
+    double *matrix = new(std::nothrow) double[size1 * size2];
+    assert(matrix != nullptr);
+
+    bool passed = true;
+    IVector::Norm norms[3] = {IVector::Norm::NORM_1, IVector::Norm::NORM_2, IVector::Norm::NORM_INF};
+    for (size_t n = 0; passed && n < 3; ++n) {
+        passed = IVectorBatch::distances(batch1, batch2, norms[n], matrix, logger) == ReturnCode::RC_SUCCESS;
+        for (size_t i = 0; passed && i < size1; ++i) {
+            IVector *vec1 = batch1->getVector(i);
+            for (size_t j = 0; passed && j < size2; ++j) {
+                IVector *vec2 = batch2->getVector(j);
+                passed = std::fabs(matrix[i * size2 + j] - IVector::distance(vec1, vec2, norms[n], logger)) < EPS;
+                delete vec2;
+            }
+            delete vec1;
+        }
+    }
+    delete batch1;
+    delete batch2;
+    delete[]matrix;
+    delete[]data;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool setExecution_Parallel_ReproducibleResults(ILogger *logger, char *&testName) {
+    size_t const dim = 300000;
+    double *data = new(std::nothrow) double[2 * dim];
+    assert(data != nullptr);
+    for (size_t i = 0; i < 2 * dim; ++i)
+        data[i] = static_cast<double>((i * 7919) % 101) / 10 - 5;
+    IVector *vec1 = IVector::createVector(dim, data, logger);
+    assert(vec1 != nullptr);
+    IVector *vec2 = IVector::createVector(dim, data + dim, logger);
+    assert(vec2 != nullptr);
+
+    double seqDot = IVector::mul(vec1, vec2, logger);
+    double seqDist = IVector::distance(vec1, vec2, IVector::Norm::NORM_1, logger);
+    bool passed = IVector::setExecution(IVector::Execution::EXEC_PARALLEL, 1000, logger) == ReturnCode::RC_SUCCESS &&
+                  IVector::getExecution() == IVector::Execution::EXEC_PARALLEL && IVector::getParallelMinDim() == 1000;
+    double parDot = IVector::mul(vec1, vec2, logger);
+    double parDist = IVector::distance(vec1, vec2, IVector::Norm::NORM_1, logger);
+    passed = passed && std::fabs(parDot - seqDot) < EPS * std::fabs(seqDot) && std::fabs(parDist - seqDist) < EPS * seqDist;
+    passed = passed && IVector::mul(vec1, vec2, logger) == parDot;
+    passed = passed && IVector::setExecution(IVector::Execution::EXEC_PARALLEL, 0, logger) != ReturnCode::RC_SUCCESS;
+    IVector::setExecution(IVector::Execution::EXEC_SEQUENTIAL);
+    passed = passed && IVector::getExecution() == IVector::Execution::EXEC_SEQUENTIAL;
+
+    delete vec1;
+    delete vec2;
+    delete[]data;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool poolEnable_Ok_RecyclesVectors(ILogger *logger, char *&testName) {
+    size_t const dim = 7;
+    double data[dim] = {1, 2, 3, 4, 5, 6, 7};
+    bool passed = IVectorPool::enable(0, logger) != ReturnCode::RC_SUCCESS &&
+                  IVectorPool::enable(dim, logger) == ReturnCode::RC_SUCCESS && IVectorPool::isEnabled(dim);
+
+    IVector *vec = IVector::createVector(dim, data, logger);
+    assert(vec != nullptr);
+    delete vec;
+    IVectorPool::Stats before = IVectorPool::getStats();
+    passed = passed && before.bytesHeld > 0;
+    for (size_t i = 0; passed && i < 100; ++i) {
+        vec = IVector::createVector(dim, data, logger);
+        IVector *cloned = vec->clone();
+        passed = cloned != nullptr && cloned->getCoord(dim - 1) == data[dim - 1];
+        delete vec;
+        delete cloned;
+    }
+    IVectorPool::Stats after = IVectorPool::getStats();
+    passed = passed && after.hits >= before.hits + 199 && after.live == before.live && after.hitRate > 0;
+
+    IVectorPool::trim();
+    passed = passed && IVectorPool::getStats().bytesHeld == 0;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool lincombMany_Ok_WeightedSum(ILogger *logger, char *&testName) {
+    size_t const dim = 1100, n = 4;
+    double *data = new(std::nothrow) double[dim * (n - 1)];
+    assert(data != nullptr);
+    for (size_t i = 0; i < dim * (n - 1); ++i)
+        data[i] = static_cast<double>((i * 7919) % 101) / 10 - 5;
+    size_t indices[2] = {3, 1050};
+    double values[2] = {2.0, -4.0};
+    IVector const *vectors[n] = {IVector::createVector(dim, data, logger), IVector::createVector(dim, data + dim, logger),
+                                 IVector::createView(dim, data + 2 * dim, 1, logger),
+                                 IVector::createSparseVector(dim, 2, indices, values, logger)};
+    double coeffs[n] = {0.5, -2.0, 3.0, 1.5};
+    double nanCoeffs[n] = {0.5, NAN, 3.0, 1.5};
+
+    IVector *sum = IVector::lincomb(coeffs, vectors, n, logger);
+    bool passed = sum != nullptr && IVector::lincomb(nanCoeffs, vectors, n, logger) == nullptr &&
+                  IVector::lincomb(coeffs, vectors, 0, logger) == nullptr;
+    for (size_t j = 0; passed && j < dim; ++j) {
+        double expected = 0;
+        for (size_t i = 0; i < n; ++i)
+            expected += coeffs[i] * vectors[i]->getCoord(j);
+        passed = std::fabs(sum->getCoord(j) - expected) < EPS;
+    }
+
+    /* with sum itself as the first input: sum + 0.5 * sum + (sum - 0.5 * data) */
+    delete vectors[0];
+    vectors[0] = sum;
+    passed = passed && IVector::lincombAccumulate(sum, coeffs, vectors, n, logger) == ReturnCode::RC_SUCCESS;
+    for (size_t j = 0; passed && j < dim; ++j) {
+        double before = 0;
+        for (size_t i = 1; i < n; ++i)
+            before += coeffs[i] * vectors[i]->getCoord(j);
+        before += coeffs[0] * data[j];
+        passed = std::fabs(sum->getCoord(j) - (2.5 * before - 0.5 * data[j])) < EPS;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        delete vectors[i];
+    delete[]data;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool hash_NearbyVectors_NeighbourKey(ILogger *logger, char *&testName) {
+    double data1[3] = {0.99, 5.5, -2.5}, data2[3] = {1.01, 5.5, -2.5};
+    IVector *vec1 = IVector::createVector(3, data1, logger);
+    assert(vec1 != nullptr);
+    IVector *vec2 = IVector::createVector(3, data2, logger);
+    assert(vec2 != nullptr);
+    IVector *copy = IVector::createView(3, data1, 1, logger);
+    assert(copy != nullptr);
+
+    uint64_t key1 = 0, key2 = 0, keyCopy = 1;
+    uint64_t keys[4];
+    size_t count = 0;
+    bool passed = IVector::hash(vec1, 1.0, key1, logger) == ReturnCode::RC_SUCCESS &&
+                  IVector::hash(vec2, 1.0, key2, logger) == ReturnCode::RC_SUCCESS &&
+                  IVector::hash(copy, 1.0, keyCopy, logger) == ReturnCode::RC_SUCCESS;
+    passed = passed && key1 == keyCopy && key1 != key2;
+    passed = passed && IVector::neighbourKeys(vec2, 1.0, 0.05, keys, 4, count, logger) == ReturnCode::RC_SUCCESS &&
+             count == 2 && keys[0] == key2 && keys[1] == key1;
+    passed = passed && IVector::neighbourKeys(vec2, 1.0, 0.6, keys, 4, count, logger) == ReturnCode::RC_INVALID_PARAMS;
+    passed = passed && IVector::neighbourKeys(vec2, 1.0, 0.5, keys, 4, count, logger) == ReturnCode::RC_OUT_OF_BOUNDS && count == 0;
+    passed = passed && IVector::hash(vec1, 0.0, key1, logger) == ReturnCode::RC_INVALID_PARAMS;
+
+    delete vec1;
+    delete vec2;
+    delete copy;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
+bool batchHash_Ok_RowKeys(ILogger *logger, char *&testName) {
+    size_t const size = 5;
+    double data[size * g_dim2] = {0.1, 0.2, 0.9, 0.1, 0.1, 0.2, 3.0, -3.0, 0.14, 0.24};
+    IVectorBatch *batch = IVectorBatch::createBatch(size, g_dim2, data, logger);
+    assert(batch != nullptr);
+
+    uint64_t keys[size], neighbours[size * 4];
+    size_t counts[size];
+    bool passed = IVectorBatch::hash(batch, 0.25, keys, logger) == ReturnCode::RC_SUCCESS &&
+                  IVectorBatch::neighbourKeys(batch, 0.25, 0.02, neighbours, 4, counts, logger) == ReturnCode::RC_SUCCESS;
+    passed = passed && keys[0] == keys[2] && keys[0] != keys[1] && keys[0] == keys[4];
+    for (size_t i = 0; passed && i < size; ++i) {
+        IVector *row = batch->getVector(i);
+        uint64_t key = 0;
+        passed = IVector::hash(row, 0.25, key, logger) == ReturnCode::RC_SUCCESS && key == keys[i] &&
+                 counts[i] >= 1 && neighbours[i * 4] == key;
+        delete row;
+    }
+    passed = passed && counts[4] == 2;
+
+    delete batch;
+    testName = const_cast<char *>(__FUNCTION__);
+    return passed;
+}
+
 
 #endif //TESTVECTOR_H
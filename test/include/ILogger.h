@@ -3,18 +3,69 @@
 
 #include "ReturnCode.h"
 #include "Export.h"
+#include <atomic>
+#include <cstddef> // size_t
+
+/* library logging macros drop call sites below this severity (0 debug, 1 info, 2 warning, 3 error) at compile time */
+#ifndef LOG_COMPILE_MIN_SEVERITY
+#define LOG_COMPILE_MIN_SEVERITY 0
+#endif
 
 class DECLSPEC ILogger {
 public:
+    enum class Severity {
+        SEV_DEBUG   = 0,
+        SEV_INFO    = 1,
+        SEV_WARNING = 2,
+        SEV_ERROR   = 3
+    };
+
+    /* what an asynchronous log() does when the queue is full */
+    enum class Overflow {
+        OVERFLOW_DROP,
+        OVERFLOW_BLOCK,
+        OVERFLOW_OVERWRITE
+    };
+
+    /* FORMAT_BINARY writes compact records with interned function names, rendered back as text
+     * by the LogDecode tool; the file is opened in binary mode. Record timestamps come from a coarse
+     * monotonic clock, a few milliseconds per tick where the platform has one */
+    enum class Format {
+        FORMAT_TEXT,
+        FORMAT_BINARY
+    };
+
+    static const size_t ASYNC_CAPACITY = 4096;
+    static const size_t RATE_BURST = 16;
+    static const size_t RATE_PERIOD_MS = 1000;
+
     static ILogger* createLogger(void* client);
+    /* records below threshold are dropped, SEV_INFO by default; isEnabled is a single relaxed load */
+    static void setThreshold(Severity threshold);
+    static Severity getThreshold();
+    static bool isEnabled(Severity severity) {
+        return static_cast<int>(severity) >= threshold_.load(std::memory_order_relaxed);
+    }
+    /* each thread logs at most burst records of one call site and ReturnCode per period and counts the rest,
+     * writing the count as one "Repeated:[N] times in [T] ms" record when the site logs again after the period,
+     * on flush() from that thread or when the thread ends. Off until this is called; burst 0 turns it off again */
+    static ReturnCode setRateLimit(size_t burst = RATE_BURST, size_t periodMs = RATE_PERIOD_MS);
+
     virtual void releaseLogger(void* client)                     = 0;
-    virtual void log(char const* message, ReturnCode returnCode) = 0;
-    virtual ReturnCode setLogFile(char const* logFileName)       = 0;
+    virtual void log(char const* message, ReturnCode returnCode, Severity severity = Severity::SEV_ERROR) = 0;
+    virtual ReturnCode setLogFile(char const* logFileName, Format format = Format::FORMAT_TEXT) = 0;
+    /* in asynchronous mode log() only queues a record of up to capacity, and a background thread writes it out;
+     * switching mode first writes everything queued, so it must not race with log() calls */
+    virtual ReturnCode setAsync(bool async, size_t capacity = ASYNC_CAPACITY, Overflow overflow = Overflow::OVERFLOW_BLOCK) = 0;
+    /* returns once every record logged before the call is written and the file flushed */
+    virtual void flush()                                         = 0;
 
     ILogger() = default;
     virtual ~ILogger() = 0;
 
 private:
+    static std::atomic<int> threshold_;
+
     ILogger(ILogger const&)            = delete;
     ILogger& operator=(ILogger const&) = delete;
 };
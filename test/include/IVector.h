@@ -5,6 +5,9 @@
 #include "ReturnCode.h"
 #include "Export.h"
 #include <cstddef> // size_t
+#include <cstdint>
+
+class IVectorArena;
 
 class DECLSPEC IVector {
     public:
@@ -14,12 +17,73 @@ class DECLSPEC IVector {
             NORM_INF
         };
 
+        enum class Storage {
+            STORAGE_DOUBLE,
+            STORAGE_FLOAT
+        };
+
+        enum class Execution {
+            EXEC_SEQUENTIAL,
+            EXEC_PARALLEL
+        };
+
+        /* default threshold of setExecution */
+        static const size_t PARALLEL_MIN_DIM = 1 << 20;
+
         static IVector* createVector(size_t dim, double* data, ILogger* logger = nullptr);
+        /* STORAGE_FLOAT rounds coordinates to float and keeps the double interface; reductions accumulate in double */
+        static IVector* createVector(size_t dim, double* data, Storage storage, ILogger* logger = nullptr);
+        /* copy of vector in the given storage */
+        static IVector* convert(IVector const* vector, Storage storage, ILogger* logger = nullptr);
+        /* takes ownership of a new[]'d data without copying it, only on success; trusted skips the NaN scan */
+        static IVector* createVectorAdopt(size_t dim, double* data, bool trusted = false, ILogger* logger = nullptr);
         static IVector* add(IVector const* addend1, IVector const* addend2, ILogger* logger = nullptr);
         static IVector* sub(IVector const* minuend, IVector const* subtrahend, ILogger* logger = nullptr);
         static IVector* mul(IVector const* multiplier, double scale, ILogger* logger = nullptr);
         static double mul(IVector const* multiplier1, IVector const* multiplier2, ILogger* logger = nullptr);
         static ReturnCode equals(IVector const* v1, IVector const* v2, Norm norm, double tolerance, bool& result, ILogger* logger = nullptr);
+        static double distance(IVector const* v1, IVector const* v2, Norm norm, ILogger* logger = nullptr);
+        static ReturnCode withinTolerance(IVector const* v1, IVector const* v2, Norm norm, double tolerance, bool& result, ILogger* logger = nullptr);
+
+        /* 64-bit key of the cell of side cellSize holding vector on a grid aligned with the origin: equal vectors get
+         * equal keys, and a vector within tolerance of another in any norm has its key among the other's neighbourKeys */
+        static ReturnCode hash(IVector const* vector, double cellSize, uint64_t& key, ILogger* logger = nullptr);
+        /* keys of every cell the box of half-width tolerance around vector touches, its own key first; tolerance may be
+         * at most cellSize / 2, so there are 2^k of them for the k coordinates within tolerance of a cell border.
+         * RC_OUT_OF_BOUNDS with count 0 when they do not fit in capacity */
+        static ReturnCode neighbourKeys(IVector const* vector, double cellSize, double tolerance, uint64_t* keys, size_t capacity, size_t& count, ILogger* logger = nullptr);
+
+        /* in-place counterparts: write into dst, which may alias an operand, and allocate nothing */
+        static ReturnCode addInPlace(IVector* dst, IVector const* addend, ILogger* logger = nullptr);
+        static ReturnCode subInPlace(IVector* dst, IVector const* subtrahend, ILogger* logger = nullptr);
+        static ReturnCode scaleInPlace(IVector* dst, double scale, ILogger* logger = nullptr);
+        static ReturnCode axpy(IVector* y, double a, IVector const* x, ILogger* logger = nullptr);
+        static ReturnCode lincomb(IVector* dst, double a, IVector const* x, double b, IVector const* y, ILogger* logger = nullptr);
+        /* sum of coeffs[i] * vectors[i] over n vectors of one dimension, in one pass over each input and one allocation */
+        static IVector* lincomb(double const* coeffs, IVector const* const* vectors, size_t n, ILogger* logger = nullptr);
+        /* dst += sum of coeffs[i] * vectors[i], without allocating; dst may be one of the vectors */
+        static ReturnCode lincombAccumulate(IVector* dst, double const* coeffs, IVector const* const* vectors, size_t n, ILogger* logger = nullptr);
+
+        /* place the result in arena (the heap when arena is null); arena results log to logger, which may be null */
+        static IVector* createVector(IVectorArena* arena, size_t dim, double* data, ILogger* logger = nullptr);
+        static IVector* clone(IVectorArena* arena, IVector const* vector, ILogger* logger = nullptr);
+        static IVector* add(IVectorArena* arena, IVector const* addend1, IVector const* addend2, ILogger* logger = nullptr);
+        static IVector* sub(IVectorArena* arena, IVector const* minuend, IVector const* subtrahend, ILogger* logger = nullptr);
+        static IVector* mul(IVectorArena* arena, IVector const* multiplier, double scale, ILogger* logger = nullptr);
+
+        /* sparse vector holding nnz non-zeros at strictly increasing indices; dot, distances, add, sub and
+         * scaling of two sparse operands run in O(nnz) */
+        static IVector* createSparseVector(size_t dim, size_t nnz, size_t const* indices, double const* values, ILogger* logger = nullptr);
+        /* non-owning view: coordinate i is data[i * stride]; data must outlive the view and is not scanned for NaN,
+         * setCoord writes through to it and clone() returns an owning copy */
+        static IVector* createView(size_t dim, double* data, size_t stride = 1, ILogger* logger = nullptr);
+
+        /* process-wide policy for norms, dot products, distances and in-place updates of contiguous vectors; under
+         * EXEC_PARALLEL, operands of at least minDim coordinates are split into fixed chunks over a shared thread pool.
+         * Results are the same on every run and thread count, but may differ in the last bits from EXEC_SEQUENTIAL */
+        static ReturnCode setExecution(Execution execution, size_t minDim = PARALLEL_MIN_DIM, ILogger* logger = nullptr);
+        static Execution getExecution();
+        static size_t getParallelMinDim();
 
         virtual IVector* clone()                                const = 0;
         virtual ReturnCode setCoord(size_t index, double value) const = 0;
@@ -27,6 +91,14 @@ class DECLSPEC IVector {
         virtual double norm(Norm norm)                          const = 0;
         virtual size_t getDim()                                 const = 0;
 
+        /* contiguous coordinate buffer, or nullptr when the storage is not contiguous; the const pointer is invalidated
+         * by writes to the vector. Once the mutable one is taken, the vector's buffer is never shared with clones
+         * and its norms are not memoized, so writes through that pointer stay private and always visible */
+        virtual double const* getData()                                                 const = 0;
+        virtual double* getData()                                                             = 0;
+        virtual ReturnCode getCoords(size_t begin, size_t count, double* dst)           const = 0;
+        virtual ReturnCode setCoords(size_t begin, size_t count, double const* src)     const = 0;
+
         IVector() = default;
         virtual ~IVector() = 0;
 
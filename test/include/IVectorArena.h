@@ -0,0 +1,29 @@
+#ifndef IVECTORARENA_H
+#define IVECTORARENA_H
+
+#include "ILogger.h"
+#include "ReturnCode.h"
+#include "Export.h"
+#include <cstddef> // size_t
+
+/* Bump-pointer region for short-lived vectors. Not thread-safe: each thread keeps its own arena.
+ * Everything allocated from it is released at once by reset() or by deleting the arena;
+ * vectors placed in it may still be deleted individually, which frees nothing. */
+class DECLSPEC IVectorArena {
+    public:
+        static IVectorArena* createArena(size_t blockSize, ILogger* logger = nullptr);
+
+        virtual void* allocate(size_t size)  = 0;
+        virtual void reset()                 = 0;
+        virtual size_t getUsed()       const = 0;
+        virtual size_t getCapacity()   const = 0;
+
+        IVectorArena() = default;
+        virtual ~IVectorArena() = 0;
+
+    private:
+        IVectorArena(IVectorArena const&)            = delete;
+        IVectorArena& operator=(IVectorArena const&) = delete;
+};
+
+#endif //IVECTORARENA_H
@@ -0,0 +1,49 @@
+#ifndef IVECTORBATCH_H
+#define IVECTORBATCH_H
+
+#include "ILogger.h"
+#include "ReturnCode.h"
+#include "Export.h"
+#include "IVector.h"
+#include <cstddef> // size_t
+
+/* N vectors of dimension dim stored row by row in one contiguous block */
+class DECLSPEC IVectorBatch {
+    public:
+        static IVectorBatch* createBatch(size_t size, size_t dim, double const* data, ILogger* logger = nullptr);
+        static IVectorBatch* createBatch(IVector const* const* vectors, size_t size, ILogger* logger = nullptr);
+        static IVectorBatch* add(IVectorBatch const* addend1, IVectorBatch const* addend2, ILogger* logger = nullptr);
+        static IVectorBatch* add(IVectorBatch const* addend1, IVector const* addend2, ILogger* logger = nullptr);
+        static IVectorBatch* sub(IVectorBatch const* minuend, IVectorBatch const* subtrahend, ILogger* logger = nullptr);
+        static IVectorBatch* sub(IVectorBatch const* minuend, IVector const* subtrahend, ILogger* logger = nullptr);
+        static IVectorBatch* mul(IVectorBatch const* multiplier, double scale, ILogger* logger = nullptr);
+        static ReturnCode mul(IVectorBatch const* multiplier1, IVectorBatch const* multiplier2, double* products, ILogger* logger = nullptr);
+        static ReturnCode norm(IVectorBatch const* batch, IVector::Norm norm, double* norms, ILogger* logger = nullptr);
+        /* matrix[i * size2 + j] = distance between row i of batch1 and row j of batch2, tiled and spread over worker
+         * threads; NORM_2 goes through |a|^2 + |b|^2 - 2ab, whose cancellation leaves an absolute error of about
+         * sqrt(eps) * |a| for nearly equal rows, which may come out as 0 */
+        static ReturnCode distances(IVectorBatch const* batch1, IVectorBatch const* batch2, IVector::Norm norm, double* matrix, ILogger* logger = nullptr);
+        /* keys[i] = IVector::hash of row i */
+        static ReturnCode hash(IVectorBatch const* batch, double cellSize, uint64_t* keys, ILogger* logger = nullptr);
+        /* IVector::neighbourKeys of row i into keys + i * capacity, their number into counts[i]; rows whose keys do not
+         * fit get count 0 and make the call return RC_OUT_OF_BOUNDS once every row is done */
+        static ReturnCode neighbourKeys(IVectorBatch const* batch, double cellSize, double tolerance, uint64_t* keys, size_t capacity, size_t* counts, ILogger* logger = nullptr);
+
+        virtual IVectorBatch* clone()                                        const = 0;
+        virtual IVector* getVector(size_t ind)                               const = 0;
+        virtual ReturnCode setVector(size_t ind, IVector const* vector)            = 0;
+        virtual ReturnCode setCoord(size_t ind, size_t index, double value)        = 0;
+        virtual double getCoord(size_t ind, size_t index)                    const = 0;
+        virtual double const* getData()                                      const = 0;
+        virtual size_t getDim()                                              const = 0;
+        virtual size_t getSize()                                             const = 0;
+
+        IVectorBatch() = default;
+        virtual ~IVectorBatch() = 0;
+
+    private:
+        IVectorBatch(IVectorBatch const&)            = delete;
+        IVectorBatch& operator=(IVectorBatch const&) = delete;
+};
+
+#endif //IVECTORBATCH_H
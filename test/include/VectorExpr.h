@@ -0,0 +1,180 @@
+#ifndef VECTOREXPR_H
+#define VECTOREXPR_H
+
+#include "IVector.h"
+#include <cmath>
+#include <new>
+
+/* Lazy vector arithmetic: vexpr(a) + 2.0 * (vexpr(b) - vexpr(c)) only builds a small tree of nodes,
+ * and assignExpr / evaluateExpr compute it in one pass without intermediate vectors.
+ * Nodes keep pointers to the vectors, not copies, so the vectors must outlive the expression. */
+namespace vector_expr {
+    /* assignExpr evaluates results of up to this many coordinates on the stack */
+    static const size_t STACK_DIM = 64;
+
+    template <class E>
+    struct Expr {
+        E const& self() const { return static_cast<E const&>(*this); }
+    };
+
+    struct Leaf : Expr<Leaf> {
+        explicit Leaf(IVector const* vec) : vec_{vec}, data_{vec != nullptr ? vec->getData() : nullptr} {}
+
+        double at(size_t i) const { return this->data_ != nullptr ? this->data_[i] : this->vec_->getCoord(i); }
+        /* 0 when a null operand or a dimension mismatch makes the expression invalid */
+        size_t dim() const { return this->vec_ != nullptr ? this->vec_->getDim() : 0; }
+        bool hasNull() const { return this->vec_ == nullptr; }
+        bool hasNaN() const { return false; }
+
+        IVector const* vec_;
+        double const* data_;
+    };
+
+    template <class L, class R>
+    struct Sum : Expr<Sum<L, R> > {
+        Sum(L const& l, R const& r) : l_(l), r_(r) {}
+
+        double at(size_t i) const { return this->l_.at(i) + this->r_.at(i); }
+        size_t dim() const { return this->l_.dim() == this->r_.dim() ? this->l_.dim() : 0; }
+        bool hasNull() const { return this->l_.hasNull() || this->r_.hasNull(); }
+        bool hasNaN() const { return this->l_.hasNaN() || this->r_.hasNaN(); }
+
+        L l_;
+        R r_;
+    };
+
+    template <class L, class R>
+    struct Diff : Expr<Diff<L, R> > {
+        Diff(L const& l, R const& r) : l_(l), r_(r) {}
+
+        double at(size_t i) const { return this->l_.at(i) - this->r_.at(i); }
+        size_t dim() const { return this->l_.dim() == this->r_.dim() ? this->l_.dim() : 0; }
+        bool hasNull() const { return this->l_.hasNull() || this->r_.hasNull(); }
+        bool hasNaN() const { return this->l_.hasNaN() || this->r_.hasNaN(); }
+
+        L l_;
+        R r_;
+    };
+
+    template <class E>
+    struct Scaled : Expr<Scaled<E> > {
+        Scaled(E const& e, double scale) : e_(e), scale_{scale} {}
+
+        double at(size_t i) const { return this->scale_ * this->e_.at(i); }
+        size_t dim() const { return this->e_.dim(); }
+        bool hasNull() const { return this->e_.hasNull(); }
+        bool hasNaN() const { return std::isnan(this->scale_) || this->e_.hasNaN(); }
+
+        E e_;
+        double scale_;
+    };
+
+    template <class L, class R>
+    Sum<L, R> operator+(Expr<L> const& l, Expr<R> const& r) {
+        return Sum<L, R>(l.self(), r.self());
+    }
+
+    template <class L, class R>
+    Diff<L, R> operator-(Expr<L> const& l, Expr<R> const& r) {
+        return Diff<L, R>(l.self(), r.self());
+    }
+
+    template <class E>
+    Scaled<E> operator*(double scale, Expr<E> const& e) {
+        return Scaled<E>(e.self(), scale);
+    }
+
+    template <class E>
+    Scaled<E> operator*(Expr<E> const& e, double scale) {
+        return Scaled<E>(e.self(), scale);
+    }
+
+    template <class E>
+    Scaled<E> operator-(Expr<E> const& e) {
+        return Scaled<E>(e.self(), -1.0);
+    }
+
+    /* logs like the library's own IVector statics, under the public function the caller used */
+    inline void logError(ILogger* logger, char const* function, ReturnCode rc) {
+        ILogger::Severity severity = ILogger::Severity::SEV_ERROR;
+        if (static_cast<int>(severity) >= LOG_COMPILE_MIN_SEVERITY && ILogger::isEnabled(severity) && logger != nullptr)
+            logger->log(function, rc, severity);
+    }
+
+    template <class E>
+    ReturnCode validate(Expr<E> const& expr, ILogger* logger, char const* function) {
+        ReturnCode rc = ReturnCode::RC_SUCCESS;
+        if (expr.self().hasNull())
+            rc = ReturnCode::RC_NULL_PTR;
+        else if (expr.self().dim() == 0)
+            rc = ReturnCode::RC_WRONG_DIM;
+        else if (expr.self().hasNaN())
+            rc = ReturnCode::RC_NAN;
+
+        if (rc != ReturnCode::RC_SUCCESS)
+            logError(logger, function, rc);
+        return rc;
+    }
+}
+
+inline vector_expr::Leaf vexpr(IVector const* vec) {
+    return vector_expr::Leaf(vec);
+}
+
+/* dst = expr in one pass; dst may also appear inside expr, and is left as it was on error */
+template <class E>
+ReturnCode assignExpr(IVector* dst, vector_expr::Expr<E> const& expr, ILogger* logger = nullptr) {
+    if (dst == nullptr) {
+        vector_expr::logError(logger, __FUNCTION__, ReturnCode::RC_NULL_PTR);
+        return ReturnCode::RC_NULL_PTR;
+    }
+    ReturnCode rc = vector_expr::validate(expr, logger, __FUNCTION__);
+    if (rc != ReturnCode::RC_SUCCESS)
+        return rc;
+    size_t dim = expr.self().dim();
+    if (dim != dst->getDim()) {
+        vector_expr::logError(logger, __FUNCTION__, ReturnCode::RC_WRONG_DIM);
+        return ReturnCode::RC_WRONG_DIM;
+    }
+
+    /* the result is committed with one setCoords, which checks it all before writing and keeps a
+     * copy-on-write destination shareable, unlike writing through the mutable getData() */
+    double stackData[vector_expr::STACK_DIM];
+    double* data = dim <= vector_expr::STACK_DIM ? stackData : new(std::nothrow)double[dim];
+    if (data == nullptr) {
+        vector_expr::logError(logger, __FUNCTION__, ReturnCode::RC_NO_MEM);
+        return ReturnCode::RC_NO_MEM;
+    }
+    for (size_t i = 0; i < dim; ++i)
+        data[i] = expr.self().at(i);
+
+    rc = dst->setCoords(0, dim, data);
+    if (data != stackData)
+        delete[]data;
+    if (rc != ReturnCode::RC_SUCCESS)
+        vector_expr::logError(logger, __FUNCTION__, rc);
+    return rc;
+}
+
+/* new heap vector holding expr, nullptr on error */
+template <class E>
+IVector* evaluateExpr(vector_expr::Expr<E> const& expr, ILogger* logger = nullptr) {
+    if (vector_expr::validate(expr, logger, __FUNCTION__) != ReturnCode::RC_SUCCESS)
+        return nullptr;
+
+    size_t dim = expr.self().dim();
+    double* data = new(std::nothrow)double[dim];
+    if (data == nullptr) {
+        vector_expr::logError(logger, __FUNCTION__, ReturnCode::RC_NO_MEM);
+        return nullptr;
+    }
+    for (size_t i = 0; i < dim; ++i)
+        data[i] = expr.self().at(i);
+
+    IVector* vec = IVector::createVectorAdopt(dim, data, true, logger);
+    if (vec == nullptr)
+        delete[]data;
+    return vec;
+}
+
+#endif //VECTOREXPR_H
@@ -0,0 +1,45 @@
+#include "../../src/Logger/LogCodec.h"
+#include <cstring>
+
+/* Renders a log written with ILogger::Format::FORMAT_BINARY as the text the logger writes by default.
+ * Usage: LogDecode <log file> [--timestamps], the text goes to stdout; --timestamps prefixes each
+ * record with its time in microseconds since the epoch. */
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3 || (argc == 3 && strcmp(argv[2], "--timestamps") != 0)) {
+        fprintf(stderr, "Usage: %s <log file> [--timestamps]\n", argv[0]);
+        return 2;
+    }
+    bool timestamps = argc == 3;
+
+    FILE *file = fopen(argv[1], "rb");
+    if (file == nullptr) {
+        fprintf(stderr, "Can not open %s\n", argv[1]);
+        return 1;
+    }
+
+    static LogDecoder decoder(file);
+    LogRecord record;
+    size_t dropped;
+    char line[256];
+    ReturnCode rc;
+    while ((rc = decoder.next(record, dropped)) == ReturnCode::RC_SUCCESS) {
+        if (dropped > 0) {
+            formatDroppedLine(line, sizeof(line), dropped);
+        } else {
+            if (record.repeated > 0)
+                formatRepeatedLine(line, sizeof(line), record);
+            else
+                formatLogLine(line, sizeof(line), record.counter, record.function, record.rc);
+            if (timestamps)
+                printf("[%lld] ", (long long)record.timestamp);
+        }
+        printf("%s\n", line);
+    }
+    fclose(file);
+
+    if (rc != ReturnCode::RC_ELEM_NOT_FOUND) {
+        fprintf(stderr, "%s is not a binary log or is truncated\n", argv[1]);
+        return 1;
+    }
+    return 0;
+} //OK